@@ -0,0 +1,568 @@
+// bahasa_bench: throughput of the compiler itself on synthetic workloads.
+//
+// Every workload is generated deterministically, every measurement is the
+// median of several runs, and results can be written as JSON and compared
+// against an earlier run so upgrades can be gated on them.
+
+#include "parser/Keywords.hpp"
+#include "parser/Lexer.hpp"
+#include "parser/Parser.hpp"
+#include "ast/AST.hpp"
+#include "codegen/Codegen.hpp"
+#include "driver/Compiler.hpp"
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/FormatVariadic.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Workload {
+    std::string name;
+    std::string source;
+};
+
+struct Result {
+    std::string workload;
+    std::string phase;
+    std::string unit;
+    double value;
+    double medianSeconds;
+    bool higherIsBetter;
+};
+
+// ---------------------------------------------------------------------------
+// Workload generators
+
+// Many small `fungsi` definitions, the first few hundred called from main
+std::string generateFunctions(int count) {
+    std::ostringstream out;
+    out << "modul main\n\n";
+    for (int i = 0; i < count; i++) {
+        out << "fungsi f" << i << "(a: int, b: int) -> int {\n"
+            << "    mutasi x: int = a * " << (i % 7 + 1) << " + b\n"
+            << "    jika x modulo 2 adalah 0 {\n"
+            << "        <- x / 2\n"
+            << "    }\n"
+            << "    <- x - " << i % 13 << "\n"
+            << "}\n\n";
+    }
+    out << "fungsi main() -> int {\n"
+        << "    mutasi total: int = 0\n";
+    for (int i = 0; i < std::min(count, 256); i++) {
+        out << "    total = total + f" << i << "(" << i << ", " << i % 5 << ")\n";
+    }
+    out << "    tampilkan(\"%d\\n\", total)\n"
+        << "    <- 0\n"
+        << "}\n";
+    return out.str();
+}
+
+// Nesting as deep as the grammar allows: `jika` inside `abaikan`, around
+// deeply parenthesized arithmetic
+std::string generateNested(int blocks, int depth) {
+    std::ostringstream out;
+    out << "modul main\n\n"
+        << "fungsi main() -> int {\n"
+        << "    mutasi v: int = 1\n";
+    for (int i = 0; i < blocks; i++) {
+        std::string expr = "v";
+        for (int d = 0; d < depth; d++) {
+            expr = "(" + expr + " + " + std::to_string(d % 9) + ")";
+        }
+        out << "    abaikan {\n"
+            << "        jika v > " << i << " {\n"
+            << "            v = " << expr << " modulo 1000\n"
+            << "        }\n"
+            << "        v = v + 1\n"
+            << "    }\n";
+    }
+    out << "    tampilkan(\"%d\\n\", v)\n"
+        << "    <- 0\n"
+        << "}\n";
+    return out.str();
+}
+
+// One huge `koleksi[int]` literal
+std::string generateArray(int elements) {
+    std::ostringstream out;
+    out << "modul main\n\n"
+        << "fungsi main() -> int {\n"
+        << "    mutasi data: koleksi[int] = [";
+    for (int i = 0; i < elements; i++) {
+        out << (i ? "," : "") << (i * 7919) % 1000;
+    }
+    out << "]\n"
+        << "    tampilkan(\"%d\\n\", data.3)\n"
+        << "    <- 0\n"
+        << "}\n";
+    return out.str();
+}
+
+// Multi-megabyte file made of function definitions
+std::string generateLarge(size_t bytes) {
+    int count = 64;
+    std::string source = generateFunctions(count);
+    while (source.size() < bytes) {
+        count *= 2;
+        source = generateFunctions(count);
+    }
+    return source;
+}
+
+// Generated-code shape: long banner comments, wide indentation and long
+// string literals, where the lexer spends its time in long runs
+std::string generateCommented(size_t bytes) {
+    std::ostringstream out;
+    out << "modul main\n\n";
+    std::string banner = "-- " + std::string(120, '=') + "\n";
+    std::string pad(24, ' ');
+    size_t written = 0;
+    for (int i = 0; written < bytes; i++) {
+        std::ostringstream fn;
+        fn << banner << "-- f" << i << ": dihasilkan otomatis, jangan diubah secara manual\n" << banner
+           << "fungsi f" << i << "(a: int) -> int {\n"
+           << pad << "mutasi hasil_perhitungan_sementara_" << i << ": int = a * 1000003 + 99991\n"
+           << pad << "tampilkan(\"" << std::string(80, 'x') << " %d\\n\", hasil_perhitungan_sementara_" << i << ")\n"
+           << pad << "<- hasil_perhitungan_sementara_" << i << "\n"
+           << "}\n\n";
+        written += fn.str().size();
+        out << fn.str();
+    }
+    out << "fungsi main() -> int {\n"
+        << "    <- f0(1)\n"
+        << "}\n";
+    return out.str();
+}
+
+// ---------------------------------------------------------------------------
+// Measurement
+
+double medianSeconds(int runs, const std::function<void()>& body) {
+    std::vector<double> samples;
+    for (int i = 0; i < runs; i++) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        samples.push_back(elapsed.count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+size_t countStatements(llvm::ArrayRef<bahasa::StmtPtr> statements) {
+    size_t count = 0;
+    for (const auto& stmt : statements) {
+        count++;
+        if (auto func = llvm::dyn_cast<bahasa::FunctionStmt>(stmt)) {
+            count += countStatements(func->body);
+        } else if (auto ifStmt = llvm::dyn_cast<bahasa::IfStmt>(stmt)) {
+            count += countStatements(ifStmt->thenBranch);
+        } else if (auto tryStmt = llvm::dyn_cast<bahasa::TryStmt>(stmt)) {
+            count += countStatements(tryStmt->tryBlock);
+        } else if (auto whileStmt = llvm::dyn_cast<bahasa::WhileStmt>(stmt)) {
+            count += countStatements(whileStmt->body);
+        } else if (auto forEach = llvm::dyn_cast<bahasa::ForEachStmt>(stmt)) {
+            count += countStatements(forEach->body);
+        }
+    }
+    return count;
+}
+
+size_t countFunctions(llvm::ArrayRef<bahasa::StmtPtr> statements) {
+    return std::count_if(statements.begin(), statements.end(), [](const bahasa::StmtPtr& stmt) {
+        return llvm::isa<bahasa::FunctionStmt>(stmt);
+    });
+}
+
+// Differential check: the parallel lexer must reproduce `expected` exactly
+// for any number of pieces, however small
+void checkParallelLexer(const Workload& workload, const std::vector<bahasa::Token>& expected) {
+    for (unsigned pieces : {2u, 3u, 7u}) {
+        bahasa::Lexer lexer(workload.source);
+        std::vector<bahasa::Token> tokens = lexer.tokenizeParallel(pieces, 1);
+        size_t mismatch = 0;
+        while (mismatch < std::min(tokens.size(), expected.size())) {
+            const auto& a = tokens[mismatch];
+            const auto& b = expected[mismatch];
+            if (a.type != b.type || a.lexeme != b.lexeme || a.line != b.line || a.column != b.column ||
+                a.offset != b.offset || a.symbol != b.symbol) {
+                break;
+            }
+            mismatch++;
+        }
+        if (mismatch != tokens.size() || tokens.size() != expected.size()) {
+            throw std::runtime_error("lexer paralel (" + std::to_string(pieces) + " bagian) berbeda dari lexer "
+                                     "sekuensial pada token " + std::to_string(mismatch));
+        }
+    }
+}
+
+std::string moduleText(const bahasa::Program& program) {
+    bahasa::Codegen codegen("main");
+    codegen.generate(program.statements);
+    std::string text;
+    llvm::raw_string_ostream out(text);
+    codegen.getModule().print(out, nullptr);
+    return out.str();
+}
+
+// Differential check: the parallel parser must produce a Program that
+// generates the same module as `expected`, however the functions are split
+void checkParallelParser(const std::vector<bahasa::Token>& tokens, const bahasa::Program& expected) {
+    std::string expectedText = moduleText(expected);
+    for (unsigned pieces : {2u, 3u, 7u}) {
+        bahasa::Parser parser(tokens);
+        bahasa::Program program = parser.parseParallel(pieces, 1);
+        if (program.moduleName != expected.moduleName ||
+            countStatements(program.statements) != countStatements(expected.statements) ||
+            moduleText(program) != expectedText) {
+            throw std::runtime_error("parser paralel (" + std::to_string(pieces) + " bagian) berbeda dari parser "
+                                     "sekuensial");
+        }
+    }
+}
+
+// --periksa: only the differential checks, nothing timed
+void checkWorkload(const Workload& workload) {
+    bahasa::Lexer lexer(workload.source);
+    std::vector<bahasa::Token> tokens = lexer.tokenize();
+    checkParallelLexer(workload, tokens);
+    bahasa::Parser parser(tokens);
+    checkParallelParser(tokens, parser.parse());
+}
+
+void benchWorkload(const Workload& workload, int runs, bool endToEnd, std::vector<Result>& results) {
+    // Lexer: tokens per second. The last lexer is kept alive because escaped
+    // string lexemes point into it
+    std::vector<bahasa::Token> tokens;
+    std::unique_ptr<bahasa::Lexer> lexer;
+    double lexSeconds = medianSeconds(runs, [&] {
+        lexer = std::make_unique<bahasa::Lexer>(workload.source);
+        tokens = lexer->tokenize();
+    });
+    results.push_back({workload.name, "lexer", "token/s", tokens.size() / lexSeconds, lexSeconds, true});
+
+    // Parallel lexer, one piece per core
+    checkParallelLexer(workload, tokens);
+    double parallelLexSeconds = medianSeconds(runs, [&] {
+        bahasa::Lexer lexer(workload.source);
+        lexer.tokenizeParallel(0, 64 * 1024);
+    });
+    results.push_back({workload.name, "lexer-par", "token/s", tokens.size() / parallelLexSeconds,
+                       parallelLexSeconds, true});
+
+    // Parser: statements per second
+    bahasa::Program program;
+    double parseSeconds = medianSeconds(runs, [&] {
+        bahasa::Parser parser(tokens);
+        program = parser.parse();
+    });
+    size_t statements = countStatements(program.statements);
+    results.push_back({workload.name, "parser", "pernyataan/s", statements / parseSeconds, parseSeconds, true});
+
+    // Parallel parser, one run of functions per core
+    checkParallelParser(tokens, program);
+    double parallelParseSeconds = medianSeconds(runs, [&] {
+        bahasa::Parser parser(tokens);
+        parser.parseParallel(0, 64);
+    });
+    results.push_back({workload.name, "parser-par", "pernyataan/s", statements / parallelParseSeconds,
+                       parallelParseSeconds, true});
+
+    // Codegen: functions per second
+    size_t functions = countFunctions(program.statements);
+    double codegenSeconds = medianSeconds(runs, [&] {
+        bahasa::Codegen codegen("main");
+        codegen.generate(program.statements);
+    });
+    results.push_back({workload.name, "codegen", "fungsi/s", functions / codegenSeconds, codegenSeconds, true});
+
+    if (!endToEnd) {
+        return;
+    }
+
+    // End-to-end susun latency, without the cache
+    llvm::SmallString<128> dir;
+    if (llvm::sys::fs::createUniqueDirectory("bahasa-bench", dir)) {
+        return;
+    }
+    llvm::SmallString<128> sourcePath(dir), outputPath(dir);
+    llvm::sys::path::append(sourcePath, workload.name + ".bh");
+    llvm::sys::path::append(outputPath, workload.name);
+    {
+        std::error_code ec;
+        llvm::raw_fd_ostream out(sourcePath, ec);
+        out << workload.source;
+    }
+
+    bahasa::CompileOptions options;
+    options.useCache = false;
+    std::ostringstream diagnostics;
+    int failures = 0;
+    double susunSeconds = medianSeconds(runs, [&] {
+        failures += bahasa::compileToExecutable(std::string(sourcePath), std::string(outputPath), options, diagnostics);
+    });
+    llvm::sys::fs::remove_directories(dir);
+    if (failures) {
+        std::cerr << workload.name << ": susun gagal: " << diagnostics.str();
+        return;
+    }
+    results.push_back({workload.name, "susun", "ms", susunSeconds * 1000, susunSeconds, false});
+}
+
+// Keyword classification on its own: every word-like lexeme of the
+// workload, through the lexer's old heap-string map and through
+// classifyWord, so the two can be compared directly
+void benchKeywords(const Workload& workload, int runs, std::vector<Result>& results) {
+    bahasa::Lexer lexer(workload.source);
+    std::vector<std::string_view> words;
+    for (const auto& token : lexer.tokenize()) {
+        if (!token.lexeme.empty() && std::isalpha(static_cast<unsigned char>(token.lexeme[0]))) {
+            words.push_back(token.lexeme);
+        }
+    }
+    constexpr int passes = 20;
+    double total = static_cast<double>(words.size()) * passes;
+
+    static const std::unordered_map<std::string, bahasa::TokenType> map = {
+        {"fungsi", bahasa::TokenType::FUNCTION}, {"int", bahasa::TokenType::INT},
+        {"mutasi", bahasa::TokenType::MUTASI},   {"jika", bahasa::TokenType::IF},
+        {"modul", bahasa::TokenType::MODUL},     {"modulo", bahasa::TokenType::MODULO},
+        {"adalah", bahasa::TokenType::ADALAH},   {"dan", bahasa::TokenType::DAN},
+        {"atau", bahasa::TokenType::ATAU},       {"koleksi", bahasa::TokenType::KOLEKSI},
+        {"abaikan", bahasa::TokenType::ABAIKAN}, {"selama", bahasa::TokenType::SELAMA},
+        {"dalam", bahasa::TokenType::DALAM},     {"berhenti", bahasa::TokenType::BERHENTI},
+        {"lanjut", bahasa::TokenType::LANJUT},
+    };
+    size_t keywordsByMap = 0;
+    double mapSeconds = medianSeconds(runs, [&] {
+        for (int pass = 0; pass < passes; pass++) {
+            for (auto word : words) {
+                auto it = map.find(std::string(word));
+                keywordsByMap += it != map.end();
+            }
+        }
+    });
+
+    size_t keywordsBySwitch = 0;
+    double switchSeconds = medianSeconds(runs, [&] {
+        for (int pass = 0; pass < passes; pass++) {
+            for (auto word : words) {
+                keywordsBySwitch += bahasa::classifyWord(word) != bahasa::TokenType::IDENTIFIER;
+            }
+        }
+    });
+    if (keywordsByMap != keywordsBySwitch) {
+        throw std::runtime_error("classifyWord tidak sesuai dengan tabel kata kunci");
+    }
+
+    results.push_back({workload.name, "kk-peta", "kata/s", total / mapSeconds, mapSeconds, true});
+    results.push_back({workload.name, "kk-saklar", "kata/s", total / switchSeconds, switchSeconds, true});
+}
+
+// ---------------------------------------------------------------------------
+// Reporting
+
+void printResults(const std::vector<Result>& results) {
+    std::cout << std::left << std::setw(12) << "beban" << std::setw(10) << "tahap"
+              << std::right << std::setw(18) << "nilai" << "  " << std::left << std::setw(14) << "satuan"
+              << std::right << std::setw(14) << "median (ms)" << "\n";
+    for (const auto& r : results) {
+        std::cout << std::left << std::setw(12) << r.workload << std::setw(10) << r.phase
+                  << std::right << std::setw(18) << std::fixed << std::setprecision(1) << r.value
+                  << "  " << std::left << std::setw(14) << r.unit
+                  << std::right << std::setw(14) << std::setprecision(3) << r.medianSeconds * 1000 << "\n";
+    }
+}
+
+llvm::json::Value toJSON(const std::vector<Result>& results, int scale, int runs) {
+    llvm::json::Array entries;
+    for (const auto& r : results) {
+        entries.push_back(llvm::json::Object{
+            {"beban", r.workload},
+            {"tahap", r.phase},
+            {"satuan", r.unit},
+            {"nilai", r.value},
+            {"median_detik", r.medianSeconds},
+            {"lebih_tinggi_lebih_baik", r.higherIsBetter},
+        });
+    }
+    return llvm::json::Object{
+        {"versi", BAHASA_VERSION},
+        {"skala", scale},
+        {"ulangan", runs},
+        {"hasil", std::move(entries)},
+    };
+}
+
+// Returns the number of results that regressed by more than thresholdPercent
+int compareWithBaseline(const std::vector<Result>& results, const std::string& path, double thresholdPercent) {
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (!buffer) {
+        std::cerr << "Galat: Tidak dapat membuka berkas pembanding: " << path << "\n";
+        return 1;
+    }
+    auto parsed = llvm::json::parse((*buffer)->getBuffer());
+    if (!parsed) {
+        std::cerr << "Galat: Berkas pembanding bukan JSON yang valid: " << llvm::toString(parsed.takeError()) << "\n";
+        return 1;
+    }
+    const llvm::json::Array* baseline = parsed->getAsObject() ? parsed->getAsObject()->getArray("hasil") : nullptr;
+    if (!baseline) {
+        std::cerr << "Galat: Berkas pembanding tidak berisi \"hasil\"\n";
+        return 1;
+    }
+
+    int regressions = 0;
+    std::cout << "\nPerbandingan dengan " << path << " (ambang " << std::defaultfloat << thresholdPercent << "%):\n";
+    for (const auto& r : results) {
+        for (const auto& entry : *baseline) {
+            const auto* object = entry.getAsObject();
+            if (!object || object->getString("beban") != llvm::StringRef(r.workload) ||
+                object->getString("tahap") != llvm::StringRef(r.phase)) {
+                continue;
+            }
+            double before = object->getNumber("nilai").getValueOr(0);
+            if (before <= 0) {
+                break;
+            }
+            double change = (r.value - before) / before * 100;
+            double regression = r.higherIsBetter ? -change : change;
+            bool failed = regression > thresholdPercent;
+            regressions += failed;
+            std::cout << "  " << std::left << std::setw(12) << r.workload << std::setw(10) << r.phase
+                      << std::right << std::showpos << std::setw(9) << std::setprecision(1) << change
+                      << std::noshowpos << "%" << (failed ? "  REGRESI" : "") << "\n";
+            break;
+        }
+    }
+    return regressions;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Penggunaan: " << program << " [opsi] [berkas.bh...]\n\n"
+              << "Berkas sumber yang diberikan diukur sebagai beban tambahan.\n\n"
+              << "Opsi:\n"
+              << "  --skala <n>     Pengali ukuran beban (default: 1)\n"
+              << "  --ulangan <n>   Jumlah pengulangan per pengukuran, diambil median (default: 5)\n"
+              << "  --beban <nama>  Hanya jalankan beban ini (fungsi, bersarang, koleksi, besar, teks)\n"
+              << "  --tanpa-susun   Lewati pengukuran susun ujung ke ujung\n"
+              << "  --periksa       Hanya bandingkan lexer dan parser paralel dengan sekuensial, tanpa pengukuran\n"
+              << "  --json <berkas> Simpan hasil sebagai JSON\n"
+              << "  --banding <berkas> Bandingkan dengan hasil JSON sebelumnya\n"
+              << "  --ambang <persen>  Batas regresi untuk --banding (default: 10)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int scale = 1;
+    int runs = 5;
+    bool endToEnd = true;
+    bool checkOnly = false;
+    std::string only;
+    std::string jsonPath;
+    std::string baselinePath;
+    double threshold = 10;
+    std::vector<std::string> sourcePaths;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--skala" && hasValue) {
+            scale = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--ulangan" && hasValue) {
+            runs = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--beban" && hasValue) {
+            only = argv[++i];
+        } else if (arg == "--tanpa-susun") {
+            endToEnd = false;
+        } else if (arg == "--periksa") {
+            checkOnly = true;
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--banding" && hasValue) {
+            baselinePath = argv[++i];
+        } else if (arg == "--ambang" && hasValue) {
+            threshold = std::stod(argv[++i]);
+        } else if (!arg.empty() && arg[0] != '-') {
+            sourcePaths.push_back(arg);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<Workload> workloads = {
+        {"fungsi", generateFunctions(2000 * scale)},
+        {"bersarang", generateNested(500 * scale, 64)},
+        {"koleksi", generateArray(20000 * scale)},
+        {"besar", generateLarge(2u * 1024 * 1024 * scale)},
+        {"teks", generateCommented(2u * 1024 * 1024 * scale)},
+    };
+    for (const auto& path : sourcePaths) {
+        auto buffer = llvm::MemoryBuffer::getFile(path);
+        if (!buffer) {
+            std::cerr << "Galat: Tidak dapat membuka berkas: " << path << "\n";
+            return 1;
+        }
+        workloads.push_back({llvm::sys::path::stem(path).str(), (*buffer)->getBuffer().str()});
+    }
+
+    std::vector<Result> results;
+    for (const auto& workload : workloads) {
+        if (!only.empty() && workload.name != only) {
+            continue;
+        }
+        try {
+            if (checkOnly) {
+                checkWorkload(workload);
+                std::cout << workload.name << ": cocok\n";
+                continue;
+            }
+            benchWorkload(workload, runs, endToEnd, results);
+            if (workload.name == "fungsi") {
+                benchKeywords(workload, runs, results);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << workload.name << ": Galat: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    if (checkOnly) {
+        return 0;
+    }
+
+    printResults(results);
+
+    if (!jsonPath.empty()) {
+        std::error_code ec;
+        llvm::raw_fd_ostream out(jsonPath, ec);
+        if (ec) {
+            std::cerr << "Galat: Tidak dapat membuka berkas keluaran: " << jsonPath << "\n";
+            return 1;
+        }
+        out << llvm::formatv("{0:2}", toJSON(results, scale, runs)) << "\n";
+    }
+
+    if (!baselinePath.empty() && compareWithBaseline(results, baselinePath, threshold) > 0) {
+        return 1;
+    }
+    return 0;
+}
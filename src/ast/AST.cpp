@@ -1,6 +1,30 @@
 #include "AST.hpp"
 
 namespace bahasa {
-// Remove all ASTPrinter implementations from here
-// The file can be empty if it has no other implementations
-} // namespace bahasa 
\ No newline at end of file
+
+const char* operatorName(BinaryOp op) {
+    switch (op) {
+        case BinaryOp::Add: return "+";
+        case BinaryOp::Sub: return "-";
+        case BinaryOp::Mul: return "*";
+        case BinaryOp::Div: return "/";
+        case BinaryOp::Mod: return "modulo";
+        case BinaryOp::And: return "dan";
+        case BinaryOp::Or: return "atau";
+        case BinaryOp::Less: return "<";
+        case BinaryOp::LessEqual: return "<=";
+        case BinaryOp::Greater: return ">";
+        case BinaryOp::GreaterEqual: return ">=";
+        case BinaryOp::Equal: return "adalah";
+    }
+    return "?";
+}
+
+const char* operatorName(UnaryOp op) {
+    switch (op) {
+        case UnaryOp::Not: return "bukan";
+    }
+    return "?";
+}
+
+} // namespace bahasa
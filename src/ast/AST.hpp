@@ -1,9 +1,15 @@
 #ifndef BAHASA_AST_HPP
 #define BAHASA_AST_HPP
 
+#include "Symbol.hpp"
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/Support/Allocator.h>
+#include <llvm/Support/Casting.h>
 #include <string>
-#include <vector>
+#include <string_view>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace bahasa {
 
@@ -12,8 +18,34 @@ class Expr;
 class Stmt;
 class ASTPrinter;  // Add this forward declaration
 
-using ExprPtr = std::shared_ptr<Expr>;
-using StmtPtr = std::shared_ptr<Stmt>;
+// Nodes are owned by the arena of the Program they were parsed into
+using ExprPtr = Expr*;
+using StmtPtr = Stmt*;
+
+// Binary operators, shared by BinaryExpr (arithmetic and logic) and
+// ComparisonExpr
+enum class BinaryOp {
+    Add,          // +
+    Sub,          // -
+    Mul,          // *
+    Div,          // /
+    Mod,          // modulo
+    And,          // dan
+    Or,           // atau
+    Less,         // <
+    LessEqual,    // <=
+    Greater,      // >
+    GreaterEqual, // >=
+    Equal         // adalah
+};
+
+enum class UnaryOp {
+    Not           // bukan
+};
+
+// Source spelling of an operator, e.g. "+" or "modulo"
+const char* operatorName(BinaryOp op);
+const char* operatorName(UnaryOp op);
 
 // Type representation
 class Type {
@@ -24,191 +56,373 @@ public:
     };
     
     Kind kind;
-    std::shared_ptr<Type> elementType;  // For array types
-    size_t arraySize;                   // For array types
+    Type* elementType = nullptr;  // For array types
+    size_t arraySize = 0;         // For array types
     
-    static std::shared_ptr<Type> createInt() {
-        auto t = std::make_shared<Type>();
-        t->kind = Kind::Int;
-        return t;
-    }
-    
-    static std::shared_ptr<Type> createArray(std::shared_ptr<Type> element, size_t size) {
-        auto t = std::make_shared<Type>();
-        t->kind = Kind::Array;
-        t->elementType = element;
-        t->arraySize = size;
-        return t;
-    }
+    explicit Type(Kind k, Type* element = nullptr, size_t size = 0)
+        : kind(k), elementType(element), arraySize(size) {}
 };
 
-// Base class for all expressions
+// Base class for all expressions. The kind tag drives isa/cast/dyn_cast
+// (llvm/Support/Casting.h) through each node's classof, and the visitors in
+// ASTVisitor.hpp. Nodes are never destroyed one by one (their arena is
+// released as a whole), so the destructor is trivial and protected.
 class Expr {
 public:
-    virtual ~Expr() = default;
+    enum class Kind {
+        Number,
+        Variable,
+        Binary,
+        String,
+        ArrayLiteral,
+        ArrayIndex,
+        ArrayAlloc,
+        ArrayAssignment,
+        Call,
+        Comparison,
+        Unary,
+        Assignment
+    };
+
+    Kind getKind() const { return kind; }
+
+protected:
+    explicit Expr(Kind k) : kind(k) {}
+    ~Expr() = default;
+
+private:
+    const Kind kind;
 };
 
 // Number literal expression
 class NumberExpr : public Expr {
 public:
+    static bool classof(const Expr* node) { return node->getKind() == Kind::Number; }
+
     int value;
-    explicit NumberExpr(int val) : value(val) {}
+    explicit NumberExpr(int val) : Expr(Kind::Number), value(val) {}
 };
 
 // Variable reference expression
 class VariableExpr : public Expr {
 public:
-    std::string name;
-    explicit VariableExpr(std::string n) : name(std::move(n)) {}
+    static bool classof(const Expr* node) { return node->getKind() == Kind::Variable; }
+
+    Symbol name;
+    explicit VariableExpr(Symbol n) : Expr(Kind::Variable), name(n) {}
 };
 
 // Binary operation expression
 class BinaryExpr : public Expr {
 public:
+    static bool classof(const Expr* node) { return node->getKind() == Kind::Binary; }
+
     ExprPtr left;
-    std::string op;
+    BinaryOp op;
     ExprPtr right;
     
-    BinaryExpr(ExprPtr l, std::string o, ExprPtr r)
-        : left(std::move(l)), op(std::move(o)), right(std::move(r)) {}
+    BinaryExpr(ExprPtr l, BinaryOp o, ExprPtr r)
+        : Expr(Kind::Binary), left(l), op(o), right(r) {}
 };
 
 // String literal expression
 class StringExpr : public Expr {
 public:
-    std::string value;
-    explicit StringExpr(std::string val) : value(std::move(val)) {}
+    static bool classof(const Expr* node) { return node->getKind() == Kind::String; }
+
+    std::string_view value;
+    explicit StringExpr(std::string_view val) : Expr(Kind::String), value(val) {}
 };
 
 // Array literal expression
 class ArrayLiteralExpr : public Expr {
 public:
-    std::vector<ExprPtr> elements;
-    explicit ArrayLiteralExpr(std::vector<ExprPtr> elems) : elements(std::move(elems)) {}
+    static bool classof(const Expr* node) { return node->getKind() == Kind::ArrayLiteral; }
+
+    llvm::ArrayRef<ExprPtr> elements;
+    explicit ArrayLiteralExpr(llvm::ArrayRef<ExprPtr> elems) : Expr(Kind::ArrayLiteral), elements(elems) {}
 };
 
 // Array indexing expression
 class ArrayIndexExpr : public Expr {
 public:
-    std::string array;
+    static bool classof(const Expr* node) { return node->getKind() == Kind::ArrayIndex; }
+
+    Symbol array;
+    ExprPtr index;
+    ArrayIndexExpr(Symbol arr, ExprPtr idx) 
+        : Expr(Kind::ArrayIndex), array(arr), index(idx) {}
+};
+
+// koleksi(size): a zeroed array whose length is only known at runtime
+class ArrayAllocExpr : public Expr {
+public:
+    static bool classof(const Expr* node) { return node->getKind() == Kind::ArrayAlloc; }
+
+    ExprPtr size;
+    explicit ArrayAllocExpr(ExprPtr s) : Expr(Kind::ArrayAlloc), size(s) {}
+};
+
+// array.index = value
+class ArrayAssignmentExpr : public Expr {
+public:
+    static bool classof(const Expr* node) { return node->getKind() == Kind::ArrayAssignment; }
+
+    Symbol array;
     ExprPtr index;
-    ArrayIndexExpr(std::string arr, ExprPtr idx) 
-        : array(std::move(arr)), index(std::move(idx)) {}
+    ExprPtr value;
+    ArrayAssignmentExpr(Symbol arr, ExprPtr idx, ExprPtr val)
+        : Expr(Kind::ArrayAssignment), array(arr), index(idx), value(val) {}
 };
 
-// Base class for all statements
+// Base class for all statements, see Expr
 class Stmt {
 public:
-    virtual ~Stmt() = default;
+    enum class Kind {
+        Function,
+        Return,
+        VarDecl,
+        If,
+        Try,
+        While,
+        ForEach,
+        Break,
+        Continue,
+        Expr
+    };
+
+    Kind getKind() const { return kind; }
+
+protected:
+    explicit Stmt(Kind k) : kind(k) {}
+    ~Stmt() = default;
+
+private:
+    const Kind kind;
 };
 
 // Function parameter
 struct Parameter {
-    std::string name;
-    std::string type;
-    Parameter(std::string n, std::string t) 
-        : name(std::move(n)), type(std::move(t)) {}
+    Symbol name;
+    std::string_view type;
+    Parameter(Symbol n, std::string_view t) 
+        : name(n), type(t) {}
 };
 
 // Function declaration
 class FunctionStmt : public Stmt {
 public:
-    std::string name;
-    std::vector<Parameter> params;
-    std::string returnType;
-    std::vector<StmtPtr> body;
+    static bool classof(const Stmt* node) { return node->getKind() == Kind::Function; }
+
+    Symbol name;
+    llvm::ArrayRef<Parameter> params;
+    std::string_view returnType;
+    llvm::ArrayRef<StmtPtr> body;
     
-    FunctionStmt(std::string n, std::vector<Parameter> p, std::string rt, std::vector<StmtPtr> b)
-        : name(std::move(n)), params(std::move(p)), returnType(std::move(rt)), body(std::move(b)) {}
+    FunctionStmt(Symbol n, llvm::ArrayRef<Parameter> p, std::string_view rt, llvm::ArrayRef<StmtPtr> b)
+        : Stmt(Kind::Function), name(n), params(p), returnType(rt), body(b) {}
 };
 
 // Return statement
 class ReturnStmt : public Stmt {
 public:
+    static bool classof(const Stmt* node) { return node->getKind() == Kind::Return; }
+
     ExprPtr value;
-    explicit ReturnStmt(ExprPtr val) : value(std::move(val)) {}
+    explicit ReturnStmt(ExprPtr val) : Stmt(Kind::Return), value(val) {}
 };
 
 // Add new expression type for function calls
 class CallExpr : public Expr {
 public:
-    std::string callee;
-    std::vector<ExprPtr> arguments;
+    static bool classof(const Expr* node) { return node->getKind() == Kind::Call; }
+
+    Symbol callee;
+    llvm::ArrayRef<ExprPtr> arguments;
     
-    CallExpr(std::string c, std::vector<ExprPtr> args)
-        : callee(std::move(c)), arguments(std::move(args)) {}
+    CallExpr(Symbol c, llvm::ArrayRef<ExprPtr> args)
+        : Expr(Kind::Call), callee(c), arguments(args) {}
 };
 
 // Add new statement type for variable declarations
 class VarDeclStmt : public Stmt {
 public:
-    std::string name;
-    std::shared_ptr<Type> type;
+    static bool classof(const Stmt* node) { return node->getKind() == Kind::VarDecl; }
+
+    Symbol name;
+    Type* type;
     ExprPtr initializer;
     
-    VarDeclStmt(std::string n, std::shared_ptr<Type> t, ExprPtr init)
-        : name(std::move(n)), type(std::move(t)), initializer(std::move(init)) {}
+    VarDeclStmt(Symbol n, Type* t, ExprPtr init)
+        : Stmt(Kind::VarDecl), name(n), type(t), initializer(init) {}
 };
 
 // Add new statement type for if statements
 class IfStmt : public Stmt {
 public:
+    static bool classof(const Stmt* node) { return node->getKind() == Kind::If; }
+
     ExprPtr condition;
-    std::vector<StmtPtr> thenBranch;
+    llvm::ArrayRef<StmtPtr> thenBranch;
     
-    IfStmt(ExprPtr cond, std::vector<StmtPtr> then)
-        : condition(std::move(cond)), thenBranch(std::move(then)) {}
+    IfStmt(ExprPtr cond, llvm::ArrayRef<StmtPtr> then)
+        : Stmt(Kind::If), condition(cond), thenBranch(then) {}
 };
 
 // Add new statement type for try blocks
 class TryStmt : public Stmt {
 public:
-    std::vector<StmtPtr> tryBlock;
+    static bool classof(const Stmt* node) { return node->getKind() == Kind::Try; }
+
+    llvm::ArrayRef<StmtPtr> tryBlock;
     
-    explicit TryStmt(std::vector<StmtPtr> block)
-        : tryBlock(std::move(block)) {}
+    explicit TryStmt(llvm::ArrayRef<StmtPtr> block)
+        : Stmt(Kind::Try), tryBlock(block) {}
+};
+
+// selama condition { body }
+class WhileStmt : public Stmt {
+public:
+    static bool classof(const Stmt* node) { return node->getKind() == Kind::While; }
+
+    ExprPtr condition;
+    llvm::ArrayRef<StmtPtr> body;
+
+    WhileStmt(ExprPtr cond, llvm::ArrayRef<StmtPtr> b)
+        : Stmt(Kind::While), condition(cond), body(b) {}
+};
+
+// selama element dalam array { body }, once per element of a koleksi
+class ForEachStmt : public Stmt {
+public:
+    static bool classof(const Stmt* node) { return node->getKind() == Kind::ForEach; }
+
+    Symbol element;
+    Symbol array;
+    llvm::ArrayRef<StmtPtr> body;
+
+    ForEachStmt(Symbol e, Symbol arr, llvm::ArrayRef<StmtPtr> b)
+        : Stmt(Kind::ForEach), element(e), array(arr), body(b) {}
+};
+
+// berhenti: leave the innermost selama
+class BreakStmt : public Stmt {
+public:
+    static bool classof(const Stmt* node) { return node->getKind() == Kind::Break; }
+
+    BreakStmt() : Stmt(Kind::Break) {}
+};
+
+// lanjut: start the next iteration of the innermost selama
+class ContinueStmt : public Stmt {
+public:
+    static bool classof(const Stmt* node) { return node->getKind() == Kind::Continue; }
+
+    ContinueStmt() : Stmt(Kind::Continue) {}
 };
 
 // Update ComparisonExpr to handle both comparison and equality
 class ComparisonExpr : public Expr {
 public:
+    static bool classof(const Expr* node) { return node->getKind() == Kind::Comparison; }
+
     ExprPtr left;
-    std::string op;  // "<=", "adalah", "modulo"
+    BinaryOp op;  // Less .. Equal
     ExprPtr right;
     
-    ComparisonExpr(ExprPtr l, std::string o, ExprPtr r)
-        : left(std::move(l)), op(std::move(o)), right(std::move(r)) {}
+    ComparisonExpr(ExprPtr l, BinaryOp o, ExprPtr r)
+        : Expr(Kind::Comparison), left(l), op(o), right(r) {}
 };
 
 // Add new statement type for expression statements (like function calls)
 class ExprStmt : public Stmt {
 public:
+    static bool classof(const Stmt* node) { return node->getKind() == Kind::Expr; }
+
     ExprPtr expr;
-    explicit ExprStmt(ExprPtr e) : expr(std::move(e)) {}
+    explicit ExprStmt(ExprPtr e) : Stmt(Kind::Expr), expr(e) {}
 };
 
 // Add this class definition
 class UnaryExpr : public Expr {
 public:
-    std::string op;
+    static bool classof(const Expr* node) { return node->getKind() == Kind::Unary; }
+
+    UnaryOp op;
     ExprPtr operand;
     
-    UnaryExpr(std::string o, ExprPtr e)
-        : op(std::move(o)), operand(std::move(e)) {}
+    UnaryExpr(UnaryOp o, ExprPtr e)
+        : Expr(Kind::Unary), op(o), operand(e) {}
 };
 
 // Add this to your expression types
 struct AssignmentExpr : public Expr {
-    std::string name;
+    static bool classof(const Expr* node) { return node->getKind() == Kind::Assignment; }
+
+    Symbol name;
     ExprPtr value;
     
-    AssignmentExpr(std::string name, ExprPtr value)
-        : name(std::move(name)), value(std::move(value)) {}
+    AssignmentExpr(Symbol name, ExprPtr value)
+        : Expr(Kind::Assignment), name(name), value(value) {}
 };
 
 // Move ASTPrinter class definition to ASTPrinter.hpp
 // Remove any ASTPrinter declarations from here
 
+// The result of parsing one source: its top-level statements and the arena
+// that every node, child list and string of the tree is allocated in. The
+// whole tree is released at once together with the Program.
+class Program {
+public:
+    std::string moduleName;
+    llvm::ArrayRef<StmtPtr> statements;
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "AST nodes are never destroyed");
+        return new (arena.Allocate<T>()) T(std::forward<Args>(args)...);
+    }
+
+    // Copy a child list built up during parsing into the arena
+    template <typename T>
+    llvm::ArrayRef<T> copy(llvm::ArrayRef<T> items) {
+        static_assert(std::is_trivially_destructible<T>::value, "AST lists are never destroyed");
+        if (items.empty()) {
+            return {};
+        }
+        T* data = arena.Allocate<T>(items.size());
+        std::uninitialized_copy(items.begin(), items.end(), data);
+        return llvm::ArrayRef<T>(data, items.size());
+    }
+
+    std::string_view copy(std::string_view text) {
+        char* data = arena.Allocate<char>(text.size());
+        std::copy(text.begin(), text.end(), data);
+        return std::string_view(data, text.size());
+    }
+
+    // Take over the nodes of a Program parsed separately (e.g. on another thread)
+    void adopt(Program&& other) {
+        adopted.push_back(std::move(other.arena));
+        for (auto& allocator : other.adopted) {
+            adopted.push_back(std::move(allocator));
+        }
+        other.adopted.clear();
+    }
+
+    size_t bytesAllocated() const {
+        size_t bytes = arena.getBytesAllocated();
+        for (const auto& allocator : adopted) {
+            bytes += allocator.getBytesAllocated();
+        }
+        return bytes;
+    }
+
+private:
+    llvm::BumpPtrAllocator arena;
+    std::vector<llvm::BumpPtrAllocator> adopted;
+};
+
 } // namespace bahasa
 
 #endif // BAHASA_AST_HPP 
\ No newline at end of file
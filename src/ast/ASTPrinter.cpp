@@ -10,90 +10,157 @@ void ASTPrinter::printBranch(const std::string& text, const std::string& prefix,
 }
 
 void ASTPrinter::printStmt(const StmtPtr& stmt, std::string prefix, bool isLast) {
-    if (auto func = std::dynamic_pointer_cast<FunctionStmt>(stmt)) {
-        printBranch("Function: " + func->name, prefix, isLast);
-        std::string newPrefix = prefix + (isLast ? "    " : "│   ");
-        
-        // Print parameters
-        for (size_t i = 0; i < func->params.size(); ++i) {
-            printBranch("Parameter: " + func->params[i].name + ": " + func->params[i].type,
-                       newPrefix, i == func->params.size() - 1);
+    std::string newPrefix = prefix + (isLast ? "    " : "│   ");
+    switch (stmt->getKind()) {
+        case Stmt::Kind::Function: {
+            auto func = llvm::cast<FunctionStmt>(stmt);
+            printBranch("Function: " + func->name.str(), prefix, isLast);
+            
+            // Print parameters
+            for (size_t i = 0; i < func->params.size(); ++i) {
+                printBranch("Parameter: " + func->params[i].name.str() + ": " + std::string(func->params[i].type),
+                           newPrefix, i == func->params.size() - 1);
+            }
+            
+            // Print body
+            for (size_t i = 0; i < func->body.size(); ++i) {
+                printStmt(func->body[i], newPrefix, i == func->body.size() - 1);
+            }
+            break;
         }
-        
-        // Print body
-        for (size_t i = 0; i < func->body.size(); ++i) {
-            printStmt(func->body[i], newPrefix, i == func->body.size() - 1);
+        case Stmt::Kind::VarDecl: {
+            auto var = llvm::cast<VarDeclStmt>(stmt);
+            printBranch("VarDecl: " + var->name.str(), prefix, isLast);
+            printExpr(var->initializer, newPrefix, true);
+            break;
         }
-    }
-    else if (auto var = std::dynamic_pointer_cast<VarDeclStmt>(stmt)) {
-        printBranch("VarDecl: " + var->name, prefix, isLast);
-        printExpr(var->initializer, prefix + (isLast ? "    " : "│   "), true);
-    }
-    else if (auto ret = std::dynamic_pointer_cast<ReturnStmt>(stmt)) {
-        printBranch("Return", prefix, isLast);
-        printExpr(ret->value, prefix + (isLast ? "    " : "│   "), true);
-    }
-    else if (auto expr = std::dynamic_pointer_cast<ExprStmt>(stmt)) {
-        printExpr(expr->expr, prefix, isLast);
-    }
-    else if (auto tryStmt = std::dynamic_pointer_cast<TryStmt>(stmt)) {
-        printBranch("Try", prefix, isLast);
-        std::string newPrefix = prefix + (isLast ? "    " : "│   ");
-        for (size_t i = 0; i < tryStmt->tryBlock.size(); ++i) {
-            printStmt(tryStmt->tryBlock[i], newPrefix, i == tryStmt->tryBlock.size() - 1);
+        case Stmt::Kind::Return:
+            printBranch("Return", prefix, isLast);
+            printExpr(llvm::cast<ReturnStmt>(stmt)->value, newPrefix, true);
+            break;
+        case Stmt::Kind::Expr:
+            printExpr(llvm::cast<ExprStmt>(stmt)->expr, prefix, isLast);
+            break;
+        case Stmt::Kind::If: {
+            auto ifStmt = llvm::cast<IfStmt>(stmt);
+            printBranch("If", prefix, isLast);
+            printExpr(ifStmt->condition, newPrefix, ifStmt->thenBranch.empty());
+            for (size_t i = 0; i < ifStmt->thenBranch.size(); ++i) {
+                printStmt(ifStmt->thenBranch[i], newPrefix, i == ifStmt->thenBranch.size() - 1);
+            }
+            break;
+        }
+        case Stmt::Kind::Try: {
+            auto tryStmt = llvm::cast<TryStmt>(stmt);
+            printBranch("Try", prefix, isLast);
+            for (size_t i = 0; i < tryStmt->tryBlock.size(); ++i) {
+                printStmt(tryStmt->tryBlock[i], newPrefix, i == tryStmt->tryBlock.size() - 1);
+            }
+            break;
+        }
+        case Stmt::Kind::While: {
+            auto whileStmt = llvm::cast<WhileStmt>(stmt);
+            printBranch("While", prefix, isLast);
+            printExpr(whileStmt->condition, newPrefix, whileStmt->body.empty());
+            for (size_t i = 0; i < whileStmt->body.size(); ++i) {
+                printStmt(whileStmt->body[i], newPrefix, i == whileStmt->body.size() - 1);
+            }
+            break;
         }
+        case Stmt::Kind::ForEach: {
+            auto forEach = llvm::cast<ForEachStmt>(stmt);
+            printBranch("ForEach: " + forEach->element.str() + " dalam " + forEach->array.str(), prefix, isLast);
+            for (size_t i = 0; i < forEach->body.size(); ++i) {
+                printStmt(forEach->body[i], newPrefix, i == forEach->body.size() - 1);
+            }
+            break;
+        }
+        case Stmt::Kind::Break:
+            printBranch("Break", prefix, isLast);
+            break;
+        case Stmt::Kind::Continue:
+            printBranch("Continue", prefix, isLast);
+            break;
     }
 }
 
 void ASTPrinter::printExpr(const ExprPtr& expr, std::string prefix, bool isLast) {
-    if (auto num = std::dynamic_pointer_cast<NumberExpr>(expr)) {
-        printBranch("Number: " + std::to_string(num->value), prefix, isLast);
-    }
-    else if (auto var = std::dynamic_pointer_cast<VariableExpr>(expr)) {
-        printBranch("Variable: " + var->name, prefix, isLast);
-    }
-    else if (auto arrayLit = std::dynamic_pointer_cast<ArrayLiteralExpr>(expr)) {
-        printBranch("ArrayLiteral", prefix, isLast);
-        std::string newPrefix = prefix + (isLast ? "    " : "│   ");
-        for (size_t i = 0; i < arrayLit->elements.size(); ++i) {
-            printExpr(arrayLit->elements[i], newPrefix, i == arrayLit->elements.size() - 1);
+    std::string newPrefix = prefix + (isLast ? "    " : "│   ");
+    switch (expr->getKind()) {
+        case Expr::Kind::Number:
+            printBranch("Number: " + std::to_string(llvm::cast<NumberExpr>(expr)->value), prefix, isLast);
+            break;
+        case Expr::Kind::Variable:
+            printBranch("Variable: " + llvm::cast<VariableExpr>(expr)->name.str(), prefix, isLast);
+            break;
+        case Expr::Kind::ArrayLiteral: {
+            auto arrayLit = llvm::cast<ArrayLiteralExpr>(expr);
+            printBranch("ArrayLiteral", prefix, isLast);
+            for (size_t i = 0; i < arrayLit->elements.size(); ++i) {
+                printExpr(arrayLit->elements[i], newPrefix, i == arrayLit->elements.size() - 1);
+            }
+            break;
         }
-    }
-    else if (auto arrayIndex = std::dynamic_pointer_cast<ArrayIndexExpr>(expr)) {
-        printBranch("ArrayIndex: " + arrayIndex->array, prefix, isLast);
-        std::string newPrefix = prefix + (isLast ? "    " : "│   ");
-        printExpr(arrayIndex->index, newPrefix, true);
-    }
-    else if (auto binary = std::dynamic_pointer_cast<BinaryExpr>(expr)) {
-        printBranch("Binary: " + binary->op, prefix, isLast);
-        std::string newPrefix = prefix + (isLast ? "    " : "│   ");
-        printExpr(binary->left, newPrefix, false);
-        printExpr(binary->right, newPrefix, true);
-    }
-    else if (auto call = std::dynamic_pointer_cast<CallExpr>(expr)) {
-        printBranch("Call: " + call->callee, prefix, isLast);
-        std::string newPrefix = prefix + (isLast ? "    " : "│   ");
-        for (size_t i = 0; i < call->arguments.size(); ++i) {
-            printExpr(call->arguments[i], newPrefix, i == call->arguments.size() - 1);
+        case Expr::Kind::ArrayIndex: {
+            auto arrayIndex = llvm::cast<ArrayIndexExpr>(expr);
+            printBranch("ArrayIndex: " + arrayIndex->array.str(), prefix, isLast);
+            printExpr(arrayIndex->index, newPrefix, true);
+            break;
+        }
+        case Expr::Kind::ArrayAlloc:
+            printBranch("ArrayAlloc", prefix, isLast);
+            printExpr(llvm::cast<ArrayAllocExpr>(expr)->size, newPrefix, true);
+            break;
+        case Expr::Kind::ArrayAssignment: {
+            auto assign = llvm::cast<ArrayAssignmentExpr>(expr);
+            printBranch("ArrayAssignment: " + assign->array.str(), prefix, isLast);
+            printExpr(assign->index, newPrefix, false);
+            printExpr(assign->value, newPrefix, true);
+            break;
+        }
+        case Expr::Kind::Binary: {
+            auto binary = llvm::cast<BinaryExpr>(expr);
+            printBranch("Binary: " + std::string(operatorName(binary->op)), prefix, isLast);
+            printExpr(binary->left, newPrefix, false);
+            printExpr(binary->right, newPrefix, true);
+            break;
+        }
+        case Expr::Kind::Call: {
+            auto call = llvm::cast<CallExpr>(expr);
+            printBranch("Call: " + call->callee.str(), prefix, isLast);
+            for (size_t i = 0; i < call->arguments.size(); ++i) {
+                printExpr(call->arguments[i], newPrefix, i == call->arguments.size() - 1);
+            }
+            break;
+        }
+        case Expr::Kind::String: {
+            std::string value(llvm::cast<StringExpr>(expr)->value);
+            value.erase(std::remove_if(value.begin(), value.end(),
+                  [](unsigned char c) { return c == '\n' || c == '\t' || c == '\r'; }),
+                  value.end());
+            printBranch("String: \"" + value + "\"", prefix, isLast);
+            break;
+        }
+        case Expr::Kind::Comparison: {
+            auto comp = llvm::cast<ComparisonExpr>(expr);
+            printBranch("Comparison: " + std::string(operatorName(comp->op)), prefix, isLast);
+            printExpr(comp->left, newPrefix, false);
+            printExpr(comp->right, newPrefix, true);
+            break;
+        }
+        case Expr::Kind::Unary: {
+            auto unary = llvm::cast<UnaryExpr>(expr);
+            printBranch("Unary: " + std::string(operatorName(unary->op)), prefix, isLast);
+            printExpr(unary->operand, newPrefix, true);
+            break;
+        }
+        case Expr::Kind::Assignment: {
+            auto assign = llvm::cast<AssignmentExpr>(expr);
+            printBranch("Assignment: " + assign->name.str(), prefix, isLast);
+            printExpr(assign->value, newPrefix, true);
+            break;
         }
-    }
-    else if (auto str = std::dynamic_pointer_cast<StringExpr>(expr)) {
-        str->value.erase(std::remove_if(str->value.begin(), str->value.end(),
-              [](unsigned char c) { return c == '\n' || c == '\t' || c == '\r'; }),
-              str->value.end());
-        printBranch("String: \"" + str->value + "\"", prefix, isLast);
-    }
-    else if (auto comp = std::dynamic_pointer_cast<ComparisonExpr>(expr)) {
-        printBranch("Comparison: " + comp->op, prefix, isLast);
-        std::string newPrefix = prefix + (isLast ? "    " : "│   ");
-        printExpr(comp->left, newPrefix, false);
-        printExpr(comp->right, newPrefix, true);
-    }
-    else if (auto unary = std::dynamic_pointer_cast<UnaryExpr>(expr)) {
-        printBranch("Unary: " + unary->op, prefix, isLast);
-        std::string newPrefix = prefix + (isLast ? "    " : "│   ");
-        printExpr(unary->operand, newPrefix, true);
     }
 }
 
-} // namespace bahasa 
\ No newline at end of file
+} // namespace bahasa
@@ -0,0 +1,146 @@
+#ifndef BAHASA_AST_VISITOR_HPP
+#define BAHASA_AST_VISITOR_HPP
+
+#include "AST.hpp"
+
+namespace bahasa {
+
+// CRTP visitors in the style of llvm::InstVisitor: visit() dispatches on the
+// node's kind with a single switch and calls Derived::visitXxx. Unhandled
+// kinds fall through to visitExpr/visitStmt, which return RetTy().
+
+template <typename Derived, typename RetTy = void>
+class ExprVisitor {
+public:
+    RetTy visit(const Expr* expr) {
+        Derived* self = static_cast<Derived*>(this);
+        switch (expr->getKind()) {
+            case Expr::Kind::Number:
+                return self->visitNumber(llvm::cast<NumberExpr>(expr));
+            case Expr::Kind::Variable:
+                return self->visitVariable(llvm::cast<VariableExpr>(expr));
+            case Expr::Kind::Binary:
+                return self->visitBinary(llvm::cast<BinaryExpr>(expr));
+            case Expr::Kind::String:
+                return self->visitString(llvm::cast<StringExpr>(expr));
+            case Expr::Kind::ArrayLiteral:
+                return self->visitArrayLiteral(llvm::cast<ArrayLiteralExpr>(expr));
+            case Expr::Kind::ArrayIndex:
+                return self->visitArrayIndex(llvm::cast<ArrayIndexExpr>(expr));
+            case Expr::Kind::ArrayAlloc:
+                return self->visitArrayAlloc(llvm::cast<ArrayAllocExpr>(expr));
+            case Expr::Kind::ArrayAssignment:
+                return self->visitArrayAssignment(llvm::cast<ArrayAssignmentExpr>(expr));
+            case Expr::Kind::Call:
+                return self->visitCall(llvm::cast<CallExpr>(expr));
+            case Expr::Kind::Comparison:
+                return self->visitComparison(llvm::cast<ComparisonExpr>(expr));
+            case Expr::Kind::Unary:
+                return self->visitUnary(llvm::cast<UnaryExpr>(expr));
+            case Expr::Kind::Assignment:
+                return self->visitAssignment(llvm::cast<AssignmentExpr>(expr));
+        }
+        return RetTy();
+    }
+
+    RetTy visitExpr(const Expr*) { return RetTy(); }
+    RetTy visitNumber(const NumberExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+    RetTy visitVariable(const VariableExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+    RetTy visitBinary(const BinaryExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+    RetTy visitString(const StringExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+    RetTy visitArrayLiteral(const ArrayLiteralExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+    RetTy visitArrayIndex(const ArrayIndexExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+    RetTy visitArrayAlloc(const ArrayAllocExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+    RetTy visitArrayAssignment(const ArrayAssignmentExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+    RetTy visitCall(const CallExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+    RetTy visitComparison(const ComparisonExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+    RetTy visitUnary(const UnaryExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+    RetTy visitAssignment(const AssignmentExpr* e) { return static_cast<Derived*>(this)->visitExpr(e); }
+};
+
+template <typename Derived, typename RetTy = void>
+class StmtVisitor {
+public:
+    RetTy visit(const Stmt* stmt) {
+        Derived* self = static_cast<Derived*>(this);
+        switch (stmt->getKind()) {
+            case Stmt::Kind::Function:
+                return self->visitFunction(llvm::cast<FunctionStmt>(stmt));
+            case Stmt::Kind::Return:
+                return self->visitReturn(llvm::cast<ReturnStmt>(stmt));
+            case Stmt::Kind::VarDecl:
+                return self->visitVarDecl(llvm::cast<VarDeclStmt>(stmt));
+            case Stmt::Kind::If:
+                return self->visitIf(llvm::cast<IfStmt>(stmt));
+            case Stmt::Kind::Try:
+                return self->visitTry(llvm::cast<TryStmt>(stmt));
+            case Stmt::Kind::While:
+                return self->visitWhile(llvm::cast<WhileStmt>(stmt));
+            case Stmt::Kind::ForEach:
+                return self->visitForEach(llvm::cast<ForEachStmt>(stmt));
+            case Stmt::Kind::Break:
+                return self->visitBreak(llvm::cast<BreakStmt>(stmt));
+            case Stmt::Kind::Continue:
+                return self->visitContinue(llvm::cast<ContinueStmt>(stmt));
+            case Stmt::Kind::Expr:
+                return self->visitExprStmt(llvm::cast<ExprStmt>(stmt));
+        }
+        return RetTy();
+    }
+
+    RetTy visitStmt(const Stmt*) { return RetTy(); }
+    RetTy visitFunction(const FunctionStmt* s) { return static_cast<Derived*>(this)->visitStmt(s); }
+    RetTy visitReturn(const ReturnStmt* s) { return static_cast<Derived*>(this)->visitStmt(s); }
+    RetTy visitVarDecl(const VarDeclStmt* s) { return static_cast<Derived*>(this)->visitStmt(s); }
+    RetTy visitIf(const IfStmt* s) { return static_cast<Derived*>(this)->visitStmt(s); }
+    RetTy visitTry(const TryStmt* s) { return static_cast<Derived*>(this)->visitStmt(s); }
+    RetTy visitWhile(const WhileStmt* s) { return static_cast<Derived*>(this)->visitStmt(s); }
+    RetTy visitForEach(const ForEachStmt* s) { return static_cast<Derived*>(this)->visitStmt(s); }
+    RetTy visitBreak(const BreakStmt* s) { return static_cast<Derived*>(this)->visitStmt(s); }
+    RetTy visitContinue(const ContinueStmt* s) { return static_cast<Derived*>(this)->visitStmt(s); }
+    RetTy visitExprStmt(const ExprStmt* s) { return static_cast<Derived*>(this)->visitStmt(s); }
+};
+
+// Visits every statement and expression of a tree, children after their
+// parent. Derived classes override the visitXxx they care about and call
+// the RecursiveVisitor version to keep descending.
+template <typename Derived>
+class RecursiveVisitor : public StmtVisitor<Derived>, public ExprVisitor<Derived> {
+public:
+    using StmtVisitor<Derived>::visit;
+    using ExprVisitor<Derived>::visit;
+
+    void visitAll(llvm::ArrayRef<StmtPtr> statements) {
+        for (const Stmt* stmt : statements) {
+            visit(stmt);
+        }
+    }
+    void visitAll(llvm::ArrayRef<ExprPtr> expressions) {
+        for (const Expr* expr : expressions) {
+            visit(expr);
+        }
+    }
+
+    void visitFunction(const FunctionStmt* s) { visitAll(s->body); }
+    void visitReturn(const ReturnStmt* s) { visit(s->value); }
+    void visitVarDecl(const VarDeclStmt* s) { visit(s->initializer); }
+    void visitIf(const IfStmt* s) { visit(s->condition); visitAll(s->thenBranch); }
+    void visitTry(const TryStmt* s) { visitAll(s->tryBlock); }
+    void visitWhile(const WhileStmt* s) { visit(s->condition); visitAll(s->body); }
+    void visitForEach(const ForEachStmt* s) { visitAll(s->body); }
+    void visitExprStmt(const ExprStmt* s) { visit(s->expr); }
+
+    void visitBinary(const BinaryExpr* e) { visit(e->left); visit(e->right); }
+    void visitArrayLiteral(const ArrayLiteralExpr* e) { visitAll(e->elements); }
+    void visitArrayIndex(const ArrayIndexExpr* e) { visit(e->index); }
+    void visitArrayAlloc(const ArrayAllocExpr* e) { visit(e->size); }
+    void visitArrayAssignment(const ArrayAssignmentExpr* e) { visit(e->index); visit(e->value); }
+    void visitCall(const CallExpr* e) { visitAll(e->arguments); }
+    void visitComparison(const ComparisonExpr* e) { visit(e->left); visit(e->right); }
+    void visitUnary(const UnaryExpr* e) { visit(e->operand); }
+    void visitAssignment(const AssignmentExpr* e) { visit(e->value); }
+};
+
+} // namespace bahasa
+
+#endif // BAHASA_AST_VISITOR_HPP
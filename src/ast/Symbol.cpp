@@ -0,0 +1,125 @@
+#include "Symbol.hpp"
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/Allocator.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+
+namespace bahasa {
+
+namespace {
+
+// Names live in the StringMap's bump allocator and never move. Ids index a
+// chunked table of views so that view() never has to take the lock: chunks
+// are allocated once and published through atomics, never reallocated.
+constexpr uint32_t kChunkBits = 12;
+constexpr uint32_t kChunkSize = 1u << kChunkBits;
+constexpr uint32_t kMaxChunks = 1u << 14;
+
+// Names past which a new SymbolScope waits for the table to be cleared
+constexpr uint32_t kScopeLimit = 1u << 20;
+
+struct SymbolTable {
+    std::shared_mutex mutex;
+    llvm::StringMap<uint32_t, llvm::BumpPtrAllocator> ids;
+    std::atomic<std::string_view*> chunks[kMaxChunks] = {};
+    uint32_t next = 1;
+
+    std::mutex scopeMutex;
+    std::condition_variable scopesClosed;
+    unsigned openScopes = 0;
+
+    SymbolTable() {
+        chunks[0] = new std::string_view[kChunkSize];
+    }
+
+    // Drops every name and all chunks but the first; no Symbol may be in use
+    void clear() {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        ids = llvm::StringMap<uint32_t, llvm::BumpPtrAllocator>();
+        for (uint32_t chunk = 1; chunk < kMaxChunks; chunk++) {
+            std::string_view* views = chunks[chunk].exchange(nullptr, std::memory_order_relaxed);
+            if (!views) {
+                break;  // Chunks are allocated in order
+            }
+            delete[] views;
+        }
+        next = 1;
+    }
+};
+
+SymbolTable& table() {
+    static SymbolTable* instance = new SymbolTable();  // Never destroyed: symbols outlive static teardown
+    return *instance;
+}
+
+} // namespace
+
+Symbol Symbol::intern(std::string_view name) {
+    if (name.empty()) {
+        return Symbol();
+    }
+    SymbolTable& t = table();
+    llvm::StringRef key(name.data(), name.size());
+    {
+        std::shared_lock<std::shared_mutex> lock(t.mutex);
+        auto it = t.ids.find(key);
+        if (it != t.ids.end()) {
+            return Symbol(it->second);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(t.mutex);
+    auto existing = t.ids.find(key);
+    if (existing != t.ids.end()) {
+        return Symbol(existing->second);
+    }
+    // Checked before inserting, so a full table never maps a name to an id without a slot
+    uint32_t id = t.next;
+    uint32_t chunk = id >> kChunkBits;
+    if (chunk >= kMaxChunks) {
+        throw std::runtime_error("Terlalu banyak nama unik");
+    }
+    auto inserted = t.ids.try_emplace(key, id);
+    if (!t.chunks[chunk].load(std::memory_order_relaxed)) {
+        t.chunks[chunk].store(new std::string_view[kChunkSize], std::memory_order_release);
+    }
+    llvm::StringRef stored = inserted.first->first();
+    t.chunks[chunk].load(std::memory_order_relaxed)[id & (kChunkSize - 1)] =
+        std::string_view(stored.data(), stored.size());
+    t.next++;
+    return Symbol(id);
+}
+
+std::string_view Symbol::view() const {
+    if (value == 0) {
+        return {};
+    }
+    // A Symbol can only be obtained after intern() wrote its slot, under a
+    // lock whose release orders that write before any later use
+    return table().chunks[value >> kChunkBits].load(std::memory_order_acquire)[value & (kChunkSize - 1)];
+}
+
+SymbolScope::SymbolScope() {
+    SymbolTable& t = table();
+    std::unique_lock<std::mutex> lock(t.scopeMutex);
+    t.scopesClosed.wait(lock, [&] {
+        std::shared_lock<std::shared_mutex> tableLock(t.mutex);
+        return t.openScopes == 0 || t.next < kScopeLimit;
+    });
+    t.openScopes++;
+}
+
+SymbolScope::~SymbolScope() {
+    SymbolTable& t = table();
+    std::lock_guard<std::mutex> lock(t.scopeMutex);
+    if (--t.openScopes == 0) {
+        t.clear();
+        t.scopesClosed.notify_all();
+    }
+}
+
+} // namespace bahasa
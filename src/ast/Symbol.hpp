@@ -0,0 +1,60 @@
+#ifndef BAHASA_SYMBOL_HPP
+#define BAHASA_SYMBOL_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace bahasa {
+
+// An interned name. The Lexer interns every identifier once; from there on
+// names are compared, hashed and used as map keys by their 32-bit id. The
+// table is process-wide and thread-safe, so symbols from concurrent
+// compilations (batch builds, the compile server) can be mixed freely.
+// Long-running processes bound its size with SymbolScope.
+class Symbol {
+public:
+    Symbol() = default;  // The empty name, id 0
+
+    static Symbol intern(std::string_view name);
+
+    uint32_t id() const { return value; }
+    bool empty() const { return value == 0; }
+
+    // The text stays valid until the table is cleared (see SymbolScope)
+    std::string_view view() const;
+    std::string str() const { return std::string(view()); }
+
+    bool operator==(Symbol other) const { return value == other.value; }
+    bool operator!=(Symbol other) const { return value != other.value; }
+
+private:
+    explicit Symbol(uint32_t id) : value(id) {}
+
+    uint32_t value = 0;
+};
+
+// Held for the length of one compilation in a long-running process, such as
+// a layani request. When the last open scope closes the table is cleared and
+// every Symbol obtained so far becomes invalid. Under constant load scopes
+// may never all close, so once the table holds too many names a new scope
+// waits for the open ones to finish first. Processes that open no scope keep
+// their names until exit.
+class SymbolScope {
+public:
+    SymbolScope();
+    ~SymbolScope();
+
+    SymbolScope(const SymbolScope&) = delete;
+    SymbolScope& operator=(const SymbolScope&) = delete;
+};
+
+} // namespace bahasa
+
+template <>
+struct std::hash<bahasa::Symbol> {
+    size_t operator()(bahasa::Symbol symbol) const { return symbol.id(); }
+};
+
+#endif // BAHASA_SYMBOL_HPP
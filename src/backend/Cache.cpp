@@ -0,0 +1,182 @@
+#include "Cache.hpp"
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#ifndef BAHASA_VERSION
+#define BAHASA_VERSION "dev"
+#endif
+
+namespace bahasa {
+
+CompilationCache::CompilationCache()
+    : CompilationCache(defaultDirectory(), defaultMaxBytes()) {}
+
+CompilationCache::CompilationCache(std::string dir, uint64_t max)
+    : directory(std::move(dir)), maxBytes(max) {
+    enabled = !directory.empty() && !llvm::sys::fs::create_directories(directory);
+}
+
+std::string CompilationCache::defaultDirectory() {
+    if (const char* dir = std::getenv("BAHASA_CACHE_DIR")) {
+        return dir;
+    }
+
+    llvm::SmallString<128> path;
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+        path = xdg;
+    } else if (const char* home = std::getenv("HOME")) {
+        path = home;
+        llvm::sys::path::append(path, ".cache");
+    } else {
+        return "";
+    }
+    llvm::sys::path::append(path, "bahasa");
+    return std::string(path);
+}
+
+uint64_t CompilationCache::defaultMaxBytes() {
+    uint64_t megabytes = 512;
+    if (const char* limit = std::getenv("BAHASA_CACHE_MB")) {
+        megabytes = std::strtoull(limit, nullptr, 10);
+    }
+    return megabytes * 1024 * 1024;
+}
+
+// Identify the compiler build itself so a rebuilt bahasa never reuses stale artifacts
+static std::string buildIdentity() {
+    static int anchor;
+    std::string identity = BAHASA_VERSION;
+    std::string executable = llvm::sys::fs::getMainExecutable(nullptr, &anchor);
+    llvm::sys::fs::file_status status;
+    if (!llvm::sys::fs::status(executable, status)) {
+        identity += executable;
+        identity += std::to_string(status.getSize());
+        identity += std::to_string(status.getLastModificationTime().time_since_epoch().count());
+    }
+    return identity;
+}
+
+std::string CompilationCache::makeKey(llvm::StringRef source, llvm::StringRef kind,
+                                      int optLevel, llvm::StringRef triple) {
+    // Looked up once: incremental builds make a key per function
+    static const std::string build = buildIdentity();
+    llvm::SHA1 hash;
+    hash.update(build);
+    hash.update(kind);
+    hash.update(std::to_string(optLevel));
+    hash.update(triple);
+    hash.update(source);
+    return llvm::toHex(hash.final(), true);
+}
+
+std::string CompilationCache::entryPath(const std::string& key) const {
+    llvm::SmallString<128> path(directory);
+    llvm::sys::path::append(path, key);
+    return std::string(path);
+}
+
+std::unique_ptr<llvm::MemoryBuffer> CompilationCache::lookup(const std::string& key) {
+    if (!enabled) {
+        return nullptr;
+    }
+
+    std::string path = entryPath(key);
+    auto buffer = llvm::MemoryBuffer::getFile(path, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+    if (!buffer) {
+        return nullptr;
+    }
+
+    // Refresh the entry so eviction sees it as recently used
+    int fd;
+    if (!llvm::sys::fs::openFileForWrite(path, fd, llvm::sys::fs::CD_OpenExisting, llvm::sys::fs::OF_Append)) {
+        llvm::sys::fs::setLastAccessAndModificationTime(fd, std::chrono::system_clock::now());
+        llvm::sys::fs::closeFile(fd);
+    }
+    return std::move(*buffer);
+}
+
+void CompilationCache::insert(const std::string& key, llvm::StringRef contents) {
+    if (!enabled) {
+        return;
+    }
+
+    // Write to a unique temporary and rename so concurrent readers never see partial entries
+    std::string path = entryPath(key);
+    llvm::SmallString<128> tempPath;
+    int fd;
+    if (llvm::sys::fs::createUniqueFile(path + ".tmp-%%%%%%", fd, tempPath)) {
+        return;
+    }
+    {
+        llvm::raw_fd_ostream out(fd, /*shouldClose=*/true);
+        out << contents;
+        out.close();
+        if (out.has_error()) {
+            out.clear_error();
+            llvm::sys::fs::remove(tempPath);
+            return;
+        }
+    }
+    if (llvm::sys::fs::rename(tempPath, path)) {
+        llvm::sys::fs::remove(tempPath);
+        return;
+    }
+
+    evict();
+}
+
+void CompilationCache::evict() {
+    struct Entry {
+        std::string path;
+        uint64_t size;
+        llvm::sys::TimePoint<> lastUsed;
+    };
+
+    // Temporaries younger than this may still be written by another process;
+    // older ones were left behind by a writer that died
+    const auto staleAfter = std::chrono::hours(1);
+    const auto now = std::chrono::system_clock::now();
+
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code ec;
+    for (llvm::sys::fs::directory_iterator it(directory, ec), end; it != end && !ec; it.increment(ec)) {
+        llvm::sys::fs::file_status status;
+        if (llvm::sys::fs::status(it->path(), status) || status.type() != llvm::sys::fs::file_type::regular_file) {
+            continue;
+        }
+        if (llvm::StringRef(it->path()).contains(".tmp-") &&
+            now - status.getLastModificationTime() < staleAfter) {
+            continue;
+        }
+        entries.push_back({it->path(), status.getSize(), status.getLastModificationTime()});
+        total += status.getSize();
+    }
+
+    if (total <= maxBytes) {
+        return;
+    }
+
+    // Least recently used first
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.lastUsed < b.lastUsed;
+    });
+    for (const auto& entry : entries) {
+        if (total <= maxBytes) {
+            break;
+        }
+        if (!llvm::sys::fs::remove(entry.path)) {
+            total -= entry.size;
+        }
+    }
+}
+
+} // namespace bahasa
@@ -0,0 +1,46 @@
+#ifndef BAHASA_CACHE_HPP
+#define BAHASA_CACHE_HPP
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace bahasa {
+
+// Content-addressed on-disk cache for build artifacts (objects, executables).
+// Entries are plain files named by their key; access refreshes the file's
+// modification time and the oldest entries are evicted once the directory
+// grows past the size limit. The cache is best effort: any I/O failure is
+// treated as a miss.
+class CompilationCache {
+public:
+    CompilationCache();
+    CompilationCache(std::string directory, uint64_t maxBytes);
+
+    // $BAHASA_CACHE_DIR, else $XDG_CACHE_HOME/bahasa, else ~/.cache/bahasa
+    static std::string defaultDirectory();
+    // $BAHASA_CACHE_MB in megabytes, else 512 MB
+    static uint64_t defaultMaxBytes();
+
+    // Hash of everything that affects the artifact: source bytes, compiler
+    // build, artifact kind, optimization level and target triple
+    static std::string makeKey(llvm::StringRef source, llvm::StringRef kind,
+                               int optLevel, llvm::StringRef triple);
+
+    std::unique_ptr<llvm::MemoryBuffer> lookup(const std::string& key);
+    void insert(const std::string& key, llvm::StringRef contents);
+
+private:
+    std::string directory;
+    uint64_t maxBytes;
+    bool enabled = false;
+
+    std::string entryPath(const std::string& key) const;
+    void evict();
+};
+
+} // namespace bahasa
+
+#endif // BAHASA_CACHE_HPP
@@ -0,0 +1,65 @@
+#include "JIT.hpp"
+#include <llvm/BinaryFormat/Magic.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Support/TargetSelect.h>
+#include <cstdio>
+#include <stdexcept>
+
+namespace bahasa {
+
+template <typename T>
+static T unwrap(llvm::Expected<T> value, const std::string& message) {
+    if (!value) {
+        throw std::runtime_error(message + ": " + llvm::toString(value.takeError()));
+    }
+    return std::move(*value);
+}
+
+JIT::JIT() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    jit = unwrap(llvm::orc::LLJITBuilder().create(), "Gagal membuat JIT");
+
+    // Resolve libc functions used by the std wrappers from this process
+    auto generator = unwrap(
+        llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+            jit->getDataLayout().getGlobalPrefix()),
+        "Gagal memuat simbol proses");
+    jit->getMainJITDylib().addGenerator(std::move(generator));
+}
+
+void JIT::addModule(std::unique_ptr<llvm::LLVMContext> context, std::unique_ptr<llvm::Module> module) {
+    module->setDataLayout(jit->getDataLayout());
+    if (auto err = jit->addIRModule(llvm::orc::ThreadSafeModule(std::move(module), std::move(context)))) {
+        throw std::runtime_error("Gagal menambahkan modul ke JIT: " + llvm::toString(std::move(err)));
+    }
+}
+
+void JIT::addObject(std::unique_ptr<llvm::MemoryBuffer> object) {
+    // An archive of codegen shards: members are loaded as their symbols are looked up
+    if (llvm::identify_magic(object->getBuffer()) == llvm::file_magic::archive) {
+        auto generator = unwrap(
+            llvm::orc::StaticLibraryDefinitionGenerator::Create(jit->getObjLinkingLayer(), std::move(object)),
+            "Gagal memuat arsip objek");
+        jit->getMainJITDylib().addGenerator(std::move(generator));
+        return;
+    }
+    if (auto err = jit->addObjectFile(std::move(object))) {
+        throw std::runtime_error("Gagal menambahkan objek ke JIT: " + llvm::toString(std::move(err)));
+    }
+}
+
+JIT::MainFunction JIT::lookupMain() {
+    auto symbol = unwrap(jit->lookup("main"), "Fungsi main tidak ditemukan");
+    return reinterpret_cast<MainFunction>(symbol.getAddress());
+}
+
+int JIT::callMain(MainFunction mainFn) {
+    int result = mainFn();
+    fflush(stdout);
+    return result;
+}
+
+} // namespace bahasa
@@ -0,0 +1,35 @@
+#ifndef BAHASA_JIT_HPP
+#define BAHASA_JIT_HPP
+
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <memory>
+
+namespace bahasa {
+
+// In-process executor for `jalankan`: modules are compiled with ORC LLJIT and
+// `main` is called directly, external symbols (printf, sleep) resolve from
+// the host process.
+class JIT {
+public:
+    JIT();
+
+    void addModule(std::unique_ptr<llvm::LLVMContext> context, std::unique_ptr<llvm::Module> module);
+    // An object file, or an archive of them
+    void addObject(std::unique_ptr<llvm::MemoryBuffer> object);
+    using MainFunction = int (*)();
+
+    // Looking up main is what triggers compilation of the added modules
+    MainFunction lookupMain();
+    static int callMain(MainFunction mainFn);
+    int runMain() { return callMain(lookupMain()); }
+
+private:
+    std::unique_ptr<llvm::orc::LLJIT> jit;
+};
+
+} // namespace bahasa
+
+#endif // BAHASA_JIT_HPP
@@ -0,0 +1,82 @@
+#include "ObjectEmitter.hpp"
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace bahasa {
+
+ObjectEmitter::ObjectEmitter(llvm::CodeGenOpt::Level level) {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    std::string triple = llvm::sys::getDefaultTargetTriple();
+    std::string error;
+    const llvm::Target* target = llvm::TargetRegistry::lookupTarget(triple, error);
+    if (!target) {
+        throw std::runtime_error("Target tidak dikenal: " + error);
+    }
+
+    // PIC so the result links into the PIE executables system compilers produce by default
+    targetMachine.reset(target->createTargetMachine(
+        triple,
+        llvm::sys::getHostCPUName(),
+        "",
+        llvm::TargetOptions(),
+        llvm::Reloc::PIC_,
+        llvm::None,
+        level
+    ));
+    if (!targetMachine) {
+        throw std::runtime_error("Gagal membuat target machine untuk " + triple);
+    }
+}
+
+void ObjectEmitter::prepare(llvm::Module& module) const {
+    module.setTargetTriple(targetMachine->getTargetTriple().str());
+    module.setDataLayout(targetMachine->createDataLayout());
+}
+
+void ObjectEmitter::emit(llvm::Module& module, const std::string& path) const {
+    std::error_code ec;
+    llvm::raw_fd_ostream out(path, ec, llvm::sys::fs::OF_None);
+    if (ec) {
+        throw std::runtime_error("Tidak dapat membuka berkas keluaran: " + path);
+    }
+    emit(module, out);
+}
+
+void ObjectEmitter::emit(llvm::Module& module, llvm::raw_pwrite_stream& out) const {
+    prepare(module);
+
+    llvm::legacy::PassManager passes;
+    if (targetMachine->addPassesToEmitFile(passes, out, nullptr, llvm::CGFT_ObjectFile)) {
+        throw std::runtime_error("Target tidak mendukung keluaran berkas objek");
+    }
+    passes.run(module);
+    out.flush();
+}
+
+void linkExecutable(const std::vector<std::string>& objects, const std::string& outputPath) {
+    std::string cmd = "cc";
+    for (const auto& object : objects) {
+        cmd += " " + object;
+    }
+    cmd += " -o " + outputPath;
+    #ifdef __APPLE__
+        cmd += " -L/usr/lib -lSystem";  // Add system library for macOS
+    #else
+        cmd += " -lc";  // Add C library for Linux
+    #endif
+    cmd += " 2>/dev/null";
+
+    if (system(cmd.c_str()) != 0) {
+        throw std::runtime_error("Gagal menautkan berkas objek ke program");
+    }
+}
+
+} // namespace bahasa
@@ -0,0 +1,35 @@
+#ifndef BAHASA_OBJECT_EMITTER_HPP
+#define BAHASA_OBJECT_EMITTER_HPP
+
+#include <llvm/IR/Module.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bahasa {
+
+// Native backend for `susun`: emits object code straight from the in-memory
+// module, only the final link goes through the system compiler driver.
+class ObjectEmitter {
+public:
+    // The code generator's own optimization level, normally following -O
+    explicit ObjectEmitter(llvm::CodeGenOpt::Level level = llvm::CodeGenOpt::Default);
+
+    // Stamp the host triple and data layout on a module before optimizing or emitting it
+    void prepare(llvm::Module& module) const;
+    void emit(llvm::Module& module, const std::string& path) const;
+    void emit(llvm::Module& module, llvm::raw_pwrite_stream& out) const;
+
+    llvm::TargetMachine& getTargetMachine() const { return *targetMachine; }
+
+private:
+    std::unique_ptr<llvm::TargetMachine> targetMachine;
+};
+
+void linkExecutable(const std::vector<std::string>& objects, const std::string& outputPath);
+
+} // namespace bahasa
+
+#endif // BAHASA_OBJECT_EMITTER_HPP
@@ -1,19 +1,53 @@
 #include "Codegen.hpp"
+#include "ast/ASTVisitor.hpp"
 #include <llvm/IR/Verifier.h>
+#include <stdexcept>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <iostream>
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/Support/TargetSelect.h>
 #include "std/PrintFunction.cpp"
 #include "std/SleepFunction.cpp"
+#include "std/ReduceFunction.cpp"
 #include "Function.cpp"
 #include "BinaryOp.cpp"
 #include "FixedArray.cpp"
+#include "DynamicArray.cpp"
 #include "IF.cpp"
 #include "Try.cpp"
+#include "Loop.cpp"
 #include "VariableDecl.cpp"
+#include "Optimize.cpp"
+#include "Fingerprint.cpp"
 
 namespace bahasa {
 
+namespace {
+
+// Which builtins a program calls, anywhere in its tree
+struct BuiltinUsage : RecursiveVisitor<BuiltinUsage> {
+    Symbol printSymbol;
+    Symbol sleepSymbol;
+    llvm::ArrayRef<Symbol> reduceSymbols;
+    bool print = false;
+    bool sleep = false;
+    bool reduce[4] = {};  // By Reduction
+
+    BuiltinUsage(Symbol printSymbol, Symbol sleepSymbol, llvm::ArrayRef<Symbol> reduceSymbols)
+        : printSymbol(printSymbol), sleepSymbol(sleepSymbol), reduceSymbols(reduceSymbols) {}
+
+    void visitCall(const CallExpr* call) {
+        print |= call->callee == printSymbol;
+        sleep |= call->callee == sleepSymbol;
+        for (size_t i = 0; i < reduceSymbols.size(); i++) {
+            reduce[i] |= call->callee == reduceSymbols[i];
+        }
+        RecursiveVisitor::visitCall(call);
+    }
+};
+
+} // namespace
+
 Codegen::Codegen(std::string moduleName) {
     context = std::make_unique<llvm::LLVMContext>();
     module = std::make_unique<llvm::Module>(moduleName, *context);
@@ -22,43 +56,30 @@ Codegen::Codegen(std::string moduleName) {
 }
 
 
-void Codegen::generate(const std::vector<StmtPtr>& statements) {
-    // First pass: Forward declare all functions and check if tampilkan is used
-    bool needsPrintFunction = false;
-    bool needsTidurFunction = false;
-    
-    // First check if we need tampilkan
+void Codegen::generate(llvm::ArrayRef<StmtPtr> statements, unsigned shard, unsigned shardCount) {
+    llvm::SmallVector<const FunctionStmt*, 0> all;
+    FunctionTable table;
     for (const auto& stmt : statements) {
-        if (auto func = std::dynamic_pointer_cast<FunctionStmt>(stmt)) {
-            for (const auto& bodyStmt : func->body) {
-                if (auto ifStmt = std::dynamic_pointer_cast<IfStmt>(bodyStmt)) {
-                    // Check inside if statements
-                    for (const auto& thenStmt : ifStmt->thenBranch) {
-                        if (auto exprStmt = std::dynamic_pointer_cast<ExprStmt>(thenStmt)) {
-                            if (auto call = std::dynamic_pointer_cast<CallExpr>(exprStmt->expr)) {
-                                if (call->callee == "tampilkan") {
-                                    needsPrintFunction = true;
-                                }
-                                if (call->callee == "tidur") {
-                                    needsTidurFunction = true;
-                                }
-                            }
-                        }
-                    }
-                }
-                else if (auto exprStmt = std::dynamic_pointer_cast<ExprStmt>(bodyStmt)) {
-                    if (auto call = std::dynamic_pointer_cast<CallExpr>(exprStmt->expr)) {
-                        if (call->callee == "tampilkan") {
-                            needsPrintFunction = true;
-                        }
-                        if (call->callee == "tidur") {
-                            needsTidurFunction = true;
-                        }
-                    }
-                }
-            }
+        if (auto func = llvm::dyn_cast<FunctionStmt>(stmt)) {
+            all.push_back(func);
+            table[func->name.id()] = func;
         }
     }
+    size_t begin = shard * all.size() / shardCount;
+    size_t end = (shard + 1) * all.size() / shardCount;
+    generateFunctions(llvm::makeArrayRef(all).slice(begin, end - begin), table);
+}
+
+void Codegen::generateFunctions(llvm::ArrayRef<const FunctionStmt*> defined, const FunctionTable& table) {
+    prototypes = &table;
+    
+    // First pass: find out which builtins these functions use
+    BuiltinUsage usage(printSymbol, sleepSymbol, reduceSymbols);
+    for (const FunctionStmt* func : defined) {
+        usage.visit(func);
+    }
+    bool needsPrintFunction = usage.print;
+    bool needsTidurFunction = usage.sleep;
     
     // Create needed functions
     if (needsPrintFunction) {
@@ -68,77 +89,133 @@ void Codegen::generate(const std::vector<StmtPtr>& statements) {
     if (needsTidurFunction) {
         createTidurFunction();
     }
-    
-    // Forward declare all user functions
-    for (const auto& stmt : statements) {
-        if (auto func = std::dynamic_pointer_cast<FunctionStmt>(stmt)) {
-            std::vector<llvm::Type*> paramTypes(func->params.size(), getIntType());
-            
-            llvm::FunctionType* funcType = llvm::FunctionType::get(
-                getIntType(),
-                paramTypes,
-                false
-            );
-            
-            llvm::Function* function = llvm::Function::Create(
-                funcType,
-                llvm::Function::ExternalLinkage,
-                func->name,
-                module.get()
-            );
-            
-            // Set parameter names
-            unsigned idx = 0;
-            for (auto& param : function->args()) {
-                param.setName(func->params[idx++].name);
-            }
-            
-            functions[func->name] = function;
+
+    // A user function of the same name takes precedence over a reduction
+    for (size_t i = 0; i < std::size(reduceSymbols); i++) {
+        if (usage.reduce[i] && !table.count(reduceSymbols[i].id())) {
+            createReduceFunction(reduceSymbols[i], static_cast<Reduction>(i));
         }
     }
     
+    // Forward declare the functions defined here, in source order
+    for (const FunctionStmt* func : defined) {
+        declareFunction(func);
+    }
+    
     // Generate function bodies
-    for (const auto& stmt : statements) {
-        if (auto func = std::dynamic_pointer_cast<FunctionStmt>(stmt)) {
-            generateFunction(func.get());
-        }
+    for (const FunctionStmt* func : defined) {
+        generateFunction(func);
     }
-
+    prototypes = nullptr;
 }
 
-
-void Codegen::generateExprStmt(const ExprStmt* stmt, llvm::Function* currentFunction) {
-    generateExpr(stmt->expr.get());
+llvm::Function* Codegen::declareFunction(const FunctionStmt* func) {
+    std::vector<llvm::Type*> paramTypes(func->params.size(), getIntType());
+    
+    llvm::FunctionType* funcType = llvm::FunctionType::get(
+        getIntType(),
+        paramTypes,
+        false
+    );
+    
+    llvm::Function* function = llvm::Function::Create(
+        funcType,
+        llvm::Function::ExternalLinkage,
+        func->name.view(),
+        module.get()
+    );
+    
+    // Set parameter names
+    unsigned idx = 0;
+    for (auto& param : function->args()) {
+        param.setName(func->params[idx++].name.view());
+    }
+    
+    functions[func->name.id()] = function;
+    return function;
 }
 
-llvm::Value* Codegen::generateExpr(const Expr* expr) {
-    if (auto num = dynamic_cast<const NumberExpr*>(expr)) {
-        return generateNumber(num);
-    }
-    else if (auto var = dynamic_cast<const VariableExpr*>(expr)) {
-        return generateVariable(var);
-    }
-    else if (auto binary = dynamic_cast<const BinaryExpr*>(expr)) {
-        return generateBinary(binary);
+// A callee by name: a builtin or function already in the module, else a
+// user function defined in another shard
+llvm::Function* Codegen::getFunction(Symbol name) {
+    if (llvm::Function* function = functions.lookup(name.id())) {
+        return function;
     }
-    else if (auto comp = dynamic_cast<const ComparisonExpr*>(expr)) {
-        return generateComparison(comp);
+    if (const FunctionStmt* func = prototypes ? prototypes->lookup(name.id()) : nullptr) {
+        return declareFunction(func);
     }
-    else if (auto call = dynamic_cast<const CallExpr*>(expr)) {
-        return generateCall(call);
-    }
-    else if (auto assign = dynamic_cast<const AssignmentExpr*>(expr)) {
-        return generateAssignment(assign);
+    return nullptr;
+}
+
+
+void Codegen::generateStmt(const Stmt* stmt, llvm::Function* currentFunction) {
+    switch (stmt->getKind()) {
+        case Stmt::Kind::Return:
+            return generateReturn(llvm::cast<ReturnStmt>(stmt), currentFunction);
+        case Stmt::Kind::VarDecl:
+            return generateVarDecl(llvm::cast<VarDeclStmt>(stmt), currentFunction);
+        case Stmt::Kind::If:
+            return generateIf(llvm::cast<IfStmt>(stmt), currentFunction);
+        case Stmt::Kind::Try:
+            return generateTryBlock(llvm::cast<TryStmt>(stmt), currentFunction);
+        case Stmt::Kind::While:
+            return generateWhile(llvm::cast<WhileStmt>(stmt), currentFunction);
+        case Stmt::Kind::ForEach:
+            return generateForEach(llvm::cast<ForEachStmt>(stmt), currentFunction);
+        case Stmt::Kind::Break:
+            return generateBreak(llvm::cast<BreakStmt>(stmt), currentFunction);
+        case Stmt::Kind::Continue:
+            return generateContinue(llvm::cast<ContinueStmt>(stmt), currentFunction);
+        case Stmt::Kind::Expr:
+            return generateExprStmt(llvm::cast<ExprStmt>(stmt), currentFunction);
+        case Stmt::Kind::Function:
+            throw std::runtime_error("Fungsi bersarang tidak didukung");
     }
-    else if (auto arrayLit = dynamic_cast<const ArrayLiteralExpr*>(expr)) {
-        return generateArrayLiteral(arrayLit);
+}
+
+void Codegen::generateBlock(llvm::ArrayRef<StmtPtr> statements, llvm::Function* currentFunction) {
+    for (const Stmt* stmt : statements) {
+        // Nothing after <-, berhenti or lanjut in the same block can run
+        if (builder->GetInsertBlock()->getTerminator()) {
+            return;
+        }
+        generateStmt(stmt, currentFunction);
     }
-    else if (auto arrayIndex = dynamic_cast<const ArrayIndexExpr*>(expr)) {
-        return generateArrayIndex(arrayIndex, nullptr);
+}
+
+void Codegen::generateExprStmt(const ExprStmt* stmt, llvm::Function* currentFunction) {
+    generateExpr(stmt->expr);
+}
+
+llvm::Value* Codegen::generateExpr(const Expr* expr) {
+    switch (expr->getKind()) {
+        case Expr::Kind::Number:
+            return generateNumber(llvm::cast<NumberExpr>(expr));
+        case Expr::Kind::Variable:
+            return generateVariable(llvm::cast<VariableExpr>(expr));
+        case Expr::Kind::Binary:
+            return generateBinary(llvm::cast<BinaryExpr>(expr));
+        case Expr::Kind::Comparison:
+            return generateComparison(llvm::cast<ComparisonExpr>(expr));
+        case Expr::Kind::Call:
+            return generateCall(llvm::cast<CallExpr>(expr));
+        case Expr::Kind::Assignment:
+            return generateAssignment(llvm::cast<AssignmentExpr>(expr));
+        case Expr::Kind::ArrayLiteral:
+            return generateArrayLiteral(llvm::cast<ArrayLiteralExpr>(expr));
+        case Expr::Kind::ArrayIndex:
+            return generateArrayIndex(llvm::cast<ArrayIndexExpr>(expr));
+        case Expr::Kind::ArrayAlloc:
+            return generateArrayAlloc(llvm::cast<ArrayAllocExpr>(expr));
+        case Expr::Kind::ArrayAssignment:
+            return generateArrayAssignment(llvm::cast<ArrayAssignmentExpr>(expr));
+        case Expr::Kind::Unary:
+            return generateUnary(llvm::cast<UnaryExpr>(expr));
+        case Expr::Kind::String:
+            break;
     }
     
-    llvm::report_fatal_error(llvm::Twine("Tipe ekspresi tidak dikenal"));
-    return nullptr;
+    throw std::runtime_error("Tipe ekspresi tidak dikenal");
 }
 
 llvm::Value* Codegen::generateNumber(const NumberExpr* num) {
@@ -146,7 +223,7 @@ llvm::Value* Codegen::generateNumber(const NumberExpr* num) {
 }
 
 
-llvm::Value* Codegen::getStringConstant(const std::string& str) {
+llvm::Value* Codegen::getStringConstant(std::string_view str) {
     return builder->CreateGlobalStringPtr(str);
 }
 
@@ -154,8 +231,24 @@ llvm::Type* Codegen::getIntType() {
     return llvm::Type::getInt32Ty(*context);
 }
 
+llvm::Function* Codegen::getCurrentFunction() const {
+    return builder->GetInsertBlock()->getParent();
+}
+
+// Stack slots live in the entry block, so code that runs repeatedly (a tail
+// recursion turned into a loop) reuses them instead of growing the stack
+llvm::AllocaInst* Codegen::createEntryAlloca(llvm::Type* type, const llvm::Twine& name) {
+    llvm::BasicBlock& entry = getCurrentFunction()->getEntryBlock();
+    llvm::IRBuilder<> entryBuilder(&entry, entry.begin());
+    return entryBuilder.CreateAlloca(type, nullptr, name);
+}
+
 void Codegen::dump(llvm::raw_ostream& os) const {
     module->print(os, nullptr);
 }
 
+void Codegen::dumpBitcode(llvm::raw_ostream& os) const {
+    llvm::WriteBitcodeToFile(*module, os);
+}
+
 } // namespace bahasa 
\ No newline at end of file
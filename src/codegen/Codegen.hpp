@@ -2,34 +2,123 @@
 #define BAHASA_CODEGEN_HPP
 
 #include "ast/AST.hpp"
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Value.h>
-#include <unordered_map>
+#include <llvm/Target/TargetMachine.h>
 #include <memory>
+#include <string>
 
 namespace bahasa {
 
+enum class OptLevel {
+    O0,
+    O1,
+    O2,
+    O3,
+    Os
+};
+
+// What a reduction builtin folds a koleksi into
+enum class Reduction {
+    Sum,      // jumlah
+    Minimum,  // minimum
+    Maximum,  // maksimum
+    Dot       // kali_titik, over two koleksi
+};
+
+// Top-level functions of a program by Symbol::id()
+using FunctionTable = llvm::DenseMap<uint32_t, const FunctionStmt*>;
+
 class Codegen {
 public:
     Codegen(std::string moduleName);
-    void generate(const std::vector<StmtPtr>& statements);
+    // Generate the functions of `shard`, one of shardCount contiguous runs of
+    // the program's functions in source order. Functions of other shards are
+    // declared external where they are called, builtins are private to each
+    // module, so the shards can be built on separate threads and linked.
+    void generate(llvm::ArrayRef<StmtPtr> statements, unsigned shard = 0, unsigned shardCount = 1);
+    // Generate just `defined`, declaring what they call from the rest of `table`
+    void generateFunctions(llvm::ArrayRef<const FunctionStmt*> defined, const FunctionTable& table);
+    // Text that changes whenever the code generated for `func` on its own
+    // could: its whole tree and the signature of every user function it calls
+    static std::string fingerprint(const FunctionStmt* func, const FunctionTable& table);
     void dump(llvm::raw_ostream& os) const;
+    void dumpBitcode(llvm::raw_ostream& os) const;
+    // Run the new PassManager default pipeline for `level` over the module,
+    // reporting per-pass timings on passTimings when given
+    void optimize(OptLevel level, llvm::TargetMachine* targetMachine = nullptr,
+                  llvm::raw_ostream* passTimings = nullptr);
+
+    llvm::Module& getModule() { return *module; }
+
+    // Hand the generated module (and the context that owns it) to a backend
+    std::unique_ptr<llvm::LLVMContext> takeContext() { return std::move(context); }
+    std::unique_ptr<llvm::Module> takeModule() { return std::move(module); }
     
 private:
     std::unique_ptr<llvm::LLVMContext> context;
     std::unique_ptr<llvm::Module> module;
     std::unique_ptr<llvm::IRBuilder<>> builder;
-    std::unordered_map<std::string, llvm::Value*> namedValues;
-    std::unordered_map<std::string, llvm::Function*> functions;
+    // Keyed by Symbol::id(), so lookups never touch the name text
+    llvm::DenseMap<uint32_t, llvm::Value*> namedValues;
+    llvm::DenseMap<uint32_t, llvm::Function*> functions;
+    const FunctionTable* prototypes = nullptr;  // Every user function, declared on demand
+    // Set while generating a function that calls itself in tail position:
+    // those calls jump back to the header, where the parameters are phis
+    llvm::BasicBlock* tailRecursionHeader = nullptr;
+    llvm::SmallVector<llvm::PHINode*, 4> tailRecursionParams;
+    Symbol currentFunctionName;
+    // Enclosing selama loops, innermost last: where lanjut and berhenti jump
+    struct LoopTargets {
+        llvm::BasicBlock* latch;
+        llvm::BasicBlock* exit;
+    };
+    llvm::SmallVector<LoopTargets, 4> loops;
+    // Set inside an abaikan block: where every failing check in it jumps
+    llvm::BasicBlock* errorTarget = nullptr;
+    // Error paths of the current function, placed after all its other blocks
+    llvm::SmallVector<llvm::BasicBlock*, 4> coldBlocks;
+    // Heap buffers of the koleksi(n) in the current function, freed on return
+    llvm::SmallVector<llvm::AllocaInst*, 4> heapArrays;
+    // { i32* data, i32 length }, the variable of a runtime-sized koleksi
+    llvm::StructType* arrayDescriptorType = nullptr;
+    Symbol printSymbol = Symbol::intern("tampilkan");
+    Symbol sleepSymbol = Symbol::intern("tidur");
+    Symbol lengthSymbol = Symbol::intern("panjang");
+    // Reduction builtins, indexed by Reduction
+    Symbol reduceSymbols[4] = {
+        Symbol::intern("jumlah"),
+        Symbol::intern("minimum"),
+        Symbol::intern("maksimum"),
+        Symbol::intern("kali_titik"),
+    };
+
+    // An array variable as its accesses see it
+    struct ArrayView {
+        llvm::ArrayType* fixedType;  // Null for a runtime-sized koleksi
+        llvm::Value* base;           // The [N x i32] alloca, or the loaded data pointer
+        llvm::Value* length;         // i32, constant for fixed arrays
+    };
     
     // Statement generators
+    void generateStmt(const Stmt* stmt, llvm::Function* currentFunction);
+    // The statements of a block, up to the first that ends the current block
+    void generateBlock(llvm::ArrayRef<StmtPtr> statements, llvm::Function* currentFunction);
     void generateFunction(const FunctionStmt* func);
     void generateReturn(const ReturnStmt* ret, llvm::Function* currentFunction);
     void generateVarDecl(const VarDeclStmt* var, llvm::Function* currentFunction);
     void generateIf(const IfStmt* ifStmt, llvm::Function* currentFunction);
     void generateTryBlock(const TryStmt* tryStmt, llvm::Function* currentFunction);
+    void generateWhile(const WhileStmt* whileStmt, llvm::Function* currentFunction);
+    void generateForEach(const ForEachStmt* forEach, llvm::Function* currentFunction);
+    void generateLoopBody(llvm::ArrayRef<StmtPtr> body, llvm::BasicBlock* latch,
+                          llvm::BasicBlock* exit, llvm::Function* currentFunction);
+    void generateBreak(const BreakStmt* breakStmt, llvm::Function* currentFunction);
+    void generateContinue(const ContinueStmt* continueStmt, llvm::Function* currentFunction);
     void generateExprStmt(const ExprStmt* exprStmt, llvm::Function* currentFunction);
     
     // Expression generators
@@ -40,20 +129,41 @@ private:
     llvm::Value* generateComparison(const ComparisonExpr* comp);
     llvm::Value* generateCall(const CallExpr* call);
     llvm::Value* generateUnary(const UnaryExpr* unary);
+    llvm::Value* emitBinaryOp(BinaryOp op, llvm::Value* left, llvm::Value* right);
     llvm::Value* generateAssignment(const AssignmentExpr* assign);
     llvm::Value* generateArrayLiteral(const ArrayLiteralExpr* arrayLiteral);
-    llvm::Value* generateArrayIndex(const ArrayIndexExpr* arrayIndex, llvm::BasicBlock* errorBlock = nullptr);
+    llvm::Value* generateArrayIndex(const ArrayIndexExpr* arrayIndex);
+    llvm::Value* generateArrayAlloc(const ArrayAllocExpr* alloc);
+    llvm::Value* generateArrayAssignment(const ArrayAssignmentExpr* assign);
+    llvm::Value* generateLength(const CallExpr* call);
     
     // Helper methods
     llvm::Type* getIntType();
+    llvm::Function* declareFunction(const FunctionStmt* func);
+    llvm::Function* getFunction(Symbol name);
     llvm::Function* getCurrentFunction() const;
     void createPrintFunction();
     void createTidurFunction();
-    llvm::Value *getStringConstant(const std::string &str);
+    void createReduceFunction(Symbol name, Reduction kind);
+    llvm::Value* generateReduceCall(const CallExpr* call, llvm::Function* callee);
+    llvm::Value* getStringConstant(std::string_view str);
+    llvm::AllocaInst* createEntryAlloca(llvm::Type* type, const llvm::Twine& name);
 
-    // Add these two method declarations
-    bool containsPrintCall(const StmtPtr& stmt);
-    bool containsSleepCall(const StmtPtr& stmt);
+    // Runtime-sized arrays and bounds checks
+    llvm::StructType* getArrayDescriptorType();
+    ArrayView getArray(Symbol name);
+    llvm::Value* elementPointer(const ArrayView& array, llvm::Value* index);
+    // Branches to inBounds when 0 <= index < length, marked as the likely side
+    void branchInBounds(const ArrayView& array, llvm::Value* index,
+                        llvm::BasicBlock* inBounds, llvm::BasicBlock* outOfBounds);
+    // An out-of-range access jumps to errorTarget, or outside abaikan reads
+    // 0 and drops the store
+    llvm::Value* loadChecked(const ArrayView& array, llvm::Value* index);
+    void storeChecked(const ArrayView& array, llvm::Value* index, llvm::Value* value);
+    // For a check that fails at compile time
+    void failCheck();
+    llvm::Value* allocateHeapArray(llvm::Value* length, llvm::AllocaInst* heapSlot);
+    void freeHeapArrays(llvm::Function* function);
 };
 
 } // namespace bahasa
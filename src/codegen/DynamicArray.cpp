@@ -0,0 +1,258 @@
+#include "codegen/Codegen.hpp"
+#include <llvm/IR/MDBuilder.h>
+
+namespace bahasa {
+
+namespace {
+
+// koleksi(n) of at most this many elements lives on the stack, in a buffer
+// reserved in the entry block; longer ones are allocated on the heap
+constexpr uint64_t stackArrayLimit = 256;
+
+} // namespace
+
+llvm::StructType* Codegen::getArrayDescriptorType() {
+    if (!arrayDescriptorType) {
+        arrayDescriptorType = llvm::StructType::create(
+            *context, {getIntType()->getPointerTo(), getIntType()}, "koleksi");
+    }
+    return arrayDescriptorType;
+}
+
+Codegen::ArrayView Codegen::getArray(Symbol name) {
+    llvm::Value* arrayPtr = namedValues.lookup(name.id());
+    if (!arrayPtr) {
+        throw std::runtime_error("Array tidak ditemukan: " + name.str());
+    }
+    if (!arrayPtr->getType()->isPointerTy()) {
+        throw std::runtime_error("Variabel bukan pointer: " + name.str());
+    }
+
+    auto alloca = llvm::dyn_cast<llvm::AllocaInst>(arrayPtr);
+    if (alloca) {
+        if (auto fixedType = llvm::dyn_cast<llvm::ArrayType>(alloca->getAllocatedType())) {
+            llvm::Value* length = llvm::ConstantInt::get(getIntType(), fixedType->getArrayNumElements());
+            return {fixedType, alloca, length};
+        }
+    }
+    if (!alloca || alloca->getAllocatedType() != arrayDescriptorType) {
+        throw std::runtime_error("Variabel bukan array: " + name.str());
+    }
+
+    llvm::Value* data = builder->CreateLoad(getIntType()->getPointerTo(),
+        builder->CreateStructGEP(arrayDescriptorType, alloca, 0), llvm::Twine(name.view()) + ".data");
+    llvm::Value* length = builder->CreateLoad(getIntType(),
+        builder->CreateStructGEP(arrayDescriptorType, alloca, 1), llvm::Twine(name.view()) + ".length");
+    return {nullptr, data, length};
+}
+
+llvm::Value* Codegen::elementPointer(const ArrayView& array, llvm::Value* index) {
+    if (array.fixedType) {
+        std::vector<llvm::Value*> indices = {
+            llvm::ConstantInt::get(*context, llvm::APInt(32, 0)),
+            index
+        };
+        return builder->CreateInBoundsGEP(array.fixedType, array.base, indices, "array.index");
+    }
+    return builder->CreateInBoundsGEP(getIntType(), array.base, index, "array.index");
+}
+
+void Codegen::branchInBounds(const ArrayView& array, llvm::Value* index,
+                             llvm::BasicBlock* inBounds, llvm::BasicBlock* outOfBounds) {
+    // Compared unsigned, a negative index is out of range as well
+    llvm::Value* valid = builder->CreateICmpULT(index, array.length, "inbounds");
+    llvm::MDBuilder weights(*context);
+    builder->CreateCondBr(valid, inBounds, outOfBounds, weights.createBranchWeights(1 << 20, 1));
+}
+
+llvm::Value* Codegen::loadChecked(const ArrayView& array, llvm::Value* index) {
+    llvm::Function* function = getCurrentFunction();
+    llvm::BasicBlock* check = builder->GetInsertBlock();
+    llvm::BasicBlock* inBounds = llvm::BasicBlock::Create(*context, "index.ok", function);
+    llvm::BasicBlock* done = errorTarget ? nullptr : llvm::BasicBlock::Create(*context, "index.done", function);
+
+    branchInBounds(array, index, inBounds, errorTarget ? errorTarget : done);
+    builder->SetInsertPoint(inBounds);
+    llvm::Value* value = builder->CreateLoad(getIntType(), elementPointer(array, index), "array.load");
+    if (errorTarget) {
+        return value;
+    }
+
+    builder->CreateBr(done);
+    builder->SetInsertPoint(done);
+    llvm::PHINode* result = builder->CreatePHI(getIntType(), 2, "array.value");
+    result->addIncoming(value, inBounds);
+    result->addIncoming(llvm::ConstantInt::get(getIntType(), 0), check);
+    return result;
+}
+
+void Codegen::storeChecked(const ArrayView& array, llvm::Value* index, llvm::Value* value) {
+    llvm::Function* function = getCurrentFunction();
+    llvm::BasicBlock* inBounds = llvm::BasicBlock::Create(*context, "index.ok", function);
+    llvm::BasicBlock* done = llvm::BasicBlock::Create(*context, "index.done", function);
+
+    branchInBounds(array, index, inBounds, errorTarget ? errorTarget : done);
+    builder->SetInsertPoint(inBounds);
+    builder->CreateStore(value, elementPointer(array, index));
+    builder->CreateBr(done);
+    builder->SetInsertPoint(done);
+}
+
+void Codegen::failCheck() {
+    if (!errorTarget) {
+        return;
+    }
+    builder->CreateBr(errorTarget);
+    // What the statement still generates goes to a block nothing reaches
+    builder->SetInsertPoint(llvm::BasicBlock::Create(*context, "unreachable", getCurrentFunction()));
+}
+
+llvm::Value* Codegen::generateArrayAlloc(const ArrayAllocExpr* alloc) {
+    llvm::Value* length = generateExpr(alloc->size);
+    if (!length->getType()->isIntegerTy()) {
+        throw std::runtime_error("Ukuran koleksi harus berupa int");
+    }
+
+    // A small constant length is an ordinary fixed-size array
+    if (auto constant = llvm::dyn_cast<llvm::ConstantInt>(length)) {
+        int64_t elements = std::max<int64_t>(constant->getSExtValue(), 0);
+        if (static_cast<uint64_t>(elements) <= stackArrayLimit) {
+            llvm::ArrayType* arrayType = llvm::ArrayType::get(getIntType(), elements);
+            llvm::AllocaInst* array = createEntryAlloca(arrayType, "koleksi");
+            builder->CreateMemSet(array, builder->getInt8(0), elements * 4, llvm::MaybeAlign(4));
+            return array;
+        }
+    }
+
+    // A negative length makes an empty koleksi
+    length = builder->CreateSelect(
+        builder->CreateICmpSLT(length, llvm::ConstantInt::get(getIntType(), 0)),
+        llvm::ConstantInt::get(getIntType(), 0), length, "koleksi.length");
+
+    llvm::AllocaInst* descriptor = createEntryAlloca(getArrayDescriptorType(), "koleksi");
+
+    // Null until this expression first allocates on the heap
+    llvm::PointerType* bytePtrType = builder->getInt8PtrTy();
+    llvm::AllocaInst* heapSlot = createEntryAlloca(bytePtrType, "koleksi.heap");
+    llvm::IRBuilder<> entryBuilder(heapSlot->getParent(), std::next(heapSlot->getIterator()));
+    entryBuilder.CreateStore(llvm::ConstantPointerNull::get(bytePtrType), heapSlot);
+    heapArrays.push_back(heapSlot);
+
+    // Run again (in a loop), this expression replaces what it made last time
+    llvm::FunctionCallee freeFunction = module->getOrInsertFunction(
+        "free", builder->getVoidTy(), bytePtrType);
+    builder->CreateCall(freeFunction, builder->CreateLoad(bytePtrType, heapSlot));
+    builder->CreateStore(llvm::ConstantPointerNull::get(bytePtrType), heapSlot);
+
+    llvm::Value* data;
+    if (llvm::isa<llvm::ConstantInt>(length)) {
+        data = allocateHeapArray(length, heapSlot);
+    } else {
+        llvm::Function* function = getCurrentFunction();
+        llvm::ArrayType* bufferType = llvm::ArrayType::get(getIntType(), stackArrayLimit);
+        llvm::AllocaInst* buffer = createEntryAlloca(bufferType, "koleksi.buffer");
+
+        llvm::BasicBlock* stackBB = llvm::BasicBlock::Create(*context, "koleksi.stack", function);
+        llvm::BasicBlock* heapBB = llvm::BasicBlock::Create(*context, "koleksi.heap", function);
+        llvm::BasicBlock* joinBB = llvm::BasicBlock::Create(*context, "koleksi.ready", function);
+        llvm::Value* small = builder->CreateICmpULE(
+            length, llvm::ConstantInt::get(getIntType(), stackArrayLimit), "koleksi.small");
+        builder->CreateCondBr(small, stackBB, heapBB);
+
+        builder->SetInsertPoint(stackBB);
+        llvm::Value* stackData = builder->CreateConstInBoundsGEP2_32(bufferType, buffer, 0, 0, "koleksi.data");
+        llvm::Value* bytes = builder->CreateNUWMul(
+            builder->CreateZExt(length, builder->getInt64Ty()), builder->getInt64(4));
+        builder->CreateMemSet(stackData, builder->getInt8(0), bytes, llvm::MaybeAlign(4));
+        builder->CreateBr(joinBB);
+
+        builder->SetInsertPoint(heapBB);
+        llvm::Value* heapData = allocateHeapArray(length, heapSlot);
+        builder->CreateBr(joinBB);
+
+        builder->SetInsertPoint(joinBB);
+        llvm::PHINode* phi = builder->CreatePHI(getIntType()->getPointerTo(), 2, "koleksi.data");
+        phi->addIncoming(stackData, stackBB);
+        phi->addIncoming(heapData, heapBB);
+        data = phi;
+    }
+
+    builder->CreateStore(data, builder->CreateStructGEP(arrayDescriptorType, descriptor, 0));
+    builder->CreateStore(length, builder->CreateStructGEP(arrayDescriptorType, descriptor, 1));
+    return descriptor;
+}
+
+llvm::Value* Codegen::allocateHeapArray(llvm::Value* length, llvm::AllocaInst* heapSlot) {
+    llvm::PointerType* bytePtrType = builder->getInt8PtrTy();
+    llvm::FunctionCallee callocFunction = module->getOrInsertFunction(
+        "calloc", bytePtrType, builder->getInt64Ty(), builder->getInt64Ty());
+    llvm::Value* memory = builder->CreateCall(callocFunction,
+        {builder->CreateZExt(length, builder->getInt64Ty()), builder->getInt64(4)}, "koleksi.heap");
+    builder->CreateStore(memory, heapSlot);
+    return builder->CreateBitCast(memory, getIntType()->getPointerTo(), "koleksi.data");
+}
+
+void Codegen::freeHeapArrays(llvm::Function* function) {
+    if (heapArrays.empty()) {
+        return;
+    }
+
+    llvm::PointerType* bytePtrType = builder->getInt8PtrTy();
+    llvm::FunctionCallee freeFunction = module->getOrInsertFunction(
+        "free", builder->getVoidTy(), bytePtrType);
+    for (llvm::BasicBlock& block : *function) {
+        auto ret = llvm::dyn_cast_or_null<llvm::ReturnInst>(block.getTerminator());
+        if (!ret) {
+            continue;
+        }
+        // The frees come between a returned call and the ret, which a
+        // musttail call does not allow
+        if (auto call = llvm::dyn_cast_or_null<llvm::CallInst>(ret->getPrevNode())) {
+            if (call->isMustTailCall()) {
+                call->setTailCallKind(llvm::CallInst::TCK_Tail);
+            }
+        }
+        builder->SetInsertPoint(ret);
+        for (llvm::AllocaInst* heapSlot : heapArrays) {
+            builder->CreateCall(freeFunction, builder->CreateLoad(bytePtrType, heapSlot));
+        }
+    }
+}
+
+llvm::Value* Codegen::generateArrayAssignment(const ArrayAssignmentExpr* assign) {
+    ArrayView array = getArray(assign->array);
+
+    // Like reading, a constant index into a fixed-size array is checked at
+    // compile time: out of range, the store is dropped or abaikan fails
+    auto numExpr = llvm::dyn_cast<NumberExpr>(assign->index);
+    llvm::Value* index = numExpr ? nullptr : generateExpr(assign->index);
+    llvm::Value* value = generateExpr(assign->value);
+    if (!value->getType()->isIntegerTy()) {
+        throw std::runtime_error("Elemen koleksi harus berupa int: " + assign->array.str());
+    }
+
+    if (array.fixedType && numExpr) {
+        if (numExpr->value >= 0 && numExpr->value < array.fixedType->getArrayNumElements()) {
+            builder->CreateStore(value, elementPointer(array, llvm::ConstantInt::get(getIntType(), numExpr->value)));
+        } else {
+            failCheck();
+        }
+        return value;
+    }
+
+    if (!index) {
+        index = generateExpr(assign->index);
+    }
+    storeChecked(array, index, value);
+    return value;
+}
+
+llvm::Value* Codegen::generateLength(const CallExpr* call) {
+    auto var = call->arguments.size() == 1 ? llvm::dyn_cast<VariableExpr>(call->arguments[0]) : nullptr;
+    if (!var) {
+        throw std::runtime_error("panjang membutuhkan 1 argumen: nama koleksi");
+    }
+    return getArray(var->name).length;
+}
+
+}
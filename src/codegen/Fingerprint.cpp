@@ -0,0 +1,173 @@
+#include "codegen/Codegen.hpp"
+#include "ast/ASTVisitor.hpp"
+#include <stdexcept>
+
+namespace bahasa {
+
+namespace {
+
+// Serializes a function tree unambiguously: every node writes its kind and
+// fields, lists their length, text is length-prefixed. Symbols are written by
+// name since ids differ between runs.
+class FingerprintWriter : public RecursiveVisitor<FingerprintWriter> {
+public:
+    FingerprintWriter(std::string& out, const FunctionTable& table) : out(out), table(table) {}
+
+    void visitExpr(const Expr* e) {
+        throw std::runtime_error("Sidik jari: jenis ekspresi tidak dikenal " +
+                                 std::to_string(static_cast<int>(e->getKind())));
+    }
+    void visitStmt(const Stmt* s) {
+        throw std::runtime_error("Sidik jari: jenis pernyataan tidak dikenal " +
+                                 std::to_string(static_cast<int>(s->getKind())));
+    }
+
+    void visitFunction(const FunctionStmt* s) {
+        tag(s);
+        put(s->name.view());
+        put(s->params.size());
+        for (const Parameter& param : s->params) {
+            put(param.name.view());
+            put(param.type);
+        }
+        put(s->returnType);
+        put(s->body.size());
+        RecursiveVisitor::visitFunction(s);
+    }
+    void visitReturn(const ReturnStmt* s) {
+        tag(s);
+        RecursiveVisitor::visitReturn(s);
+    }
+    void visitVarDecl(const VarDeclStmt* s) {
+        tag(s);
+        put(s->name.view());
+        putType(s->type);
+        RecursiveVisitor::visitVarDecl(s);
+    }
+    void visitIf(const IfStmt* s) {
+        tag(s);
+        put(s->thenBranch.size());
+        RecursiveVisitor::visitIf(s);
+    }
+    void visitTry(const TryStmt* s) {
+        tag(s);
+        put(s->tryBlock.size());
+        RecursiveVisitor::visitTry(s);
+    }
+    void visitWhile(const WhileStmt* s) {
+        tag(s);
+        put(s->body.size());
+        RecursiveVisitor::visitWhile(s);
+    }
+    void visitForEach(const ForEachStmt* s) {
+        tag(s);
+        put(s->element.view());
+        put(s->array.view());
+        put(s->body.size());
+        RecursiveVisitor::visitForEach(s);
+    }
+    void visitBreak(const BreakStmt* s) { tag(s); }
+    void visitContinue(const ContinueStmt* s) { tag(s); }
+    void visitExprStmt(const ExprStmt* s) {
+        tag(s);
+        RecursiveVisitor::visitExprStmt(s);
+    }
+
+    void visitNumber(const NumberExpr* e) {
+        tag(e);
+        put(e->value);
+    }
+    void visitVariable(const VariableExpr* e) {
+        tag(e);
+        put(e->name.view());
+    }
+    void visitString(const StringExpr* e) {
+        tag(e);
+        put(e->value);
+    }
+    void visitBinary(const BinaryExpr* e) {
+        tag(e);
+        put(static_cast<int>(e->op));
+        RecursiveVisitor::visitBinary(e);
+    }
+    void visitComparison(const ComparisonExpr* e) {
+        tag(e);
+        put(static_cast<int>(e->op));
+        RecursiveVisitor::visitComparison(e);
+    }
+    void visitUnary(const UnaryExpr* e) {
+        tag(e);
+        put(static_cast<int>(e->op));
+        RecursiveVisitor::visitUnary(e);
+    }
+    void visitArrayLiteral(const ArrayLiteralExpr* e) {
+        tag(e);
+        put(e->elements.size());
+        RecursiveVisitor::visitArrayLiteral(e);
+    }
+    void visitArrayIndex(const ArrayIndexExpr* e) {
+        tag(e);
+        put(e->array.view());
+        RecursiveVisitor::visitArrayIndex(e);
+    }
+    void visitArrayAlloc(const ArrayAllocExpr* e) {
+        tag(e);
+        RecursiveVisitor::visitArrayAlloc(e);
+    }
+    void visitArrayAssignment(const ArrayAssignmentExpr* e) {
+        tag(e);
+        put(e->array.view());
+        RecursiveVisitor::visitArrayAssignment(e);
+    }
+    void visitAssignment(const AssignmentExpr* e) {
+        tag(e);
+        put(e->name.view());
+        RecursiveVisitor::visitAssignment(e);
+    }
+    void visitCall(const CallExpr* e) {
+        tag(e);
+        put(e->callee.view());
+        put(e->arguments.size());
+        // The callee's signature is all a separately compiled caller depends on
+        if (const FunctionStmt* callee = table.lookup(e->callee.id())) {
+            put(callee->params.size());
+            put(callee->returnType);
+        } else {
+            put(-1);
+        }
+        RecursiveVisitor::visitCall(e);
+    }
+
+private:
+    std::string& out;
+    const FunctionTable& table;
+
+    void tag(const Expr* e) { out += 'e'; put(static_cast<int>(e->getKind())); }
+    void tag(const Stmt* s) { out += 's'; put(static_cast<int>(s->getKind())); }
+    void put(long long value) {
+        out += std::to_string(value);
+        out += ';';
+    }
+    void put(std::string_view text) {
+        put(static_cast<long long>(text.size()));
+        out += text;
+    }
+    void putType(const Type* type) {
+        put(type ? static_cast<int>(type->kind) : -1);
+        if (type) {
+            put(static_cast<long long>(type->arraySize));
+            putType(type->elementType);
+        }
+    }
+};
+
+} // namespace
+
+std::string Codegen::fingerprint(const FunctionStmt* func, const FunctionTable& table) {
+    std::string text;
+    FingerprintWriter writer(text, table);
+    writer.visit(func);
+    return text;
+}
+
+} // namespace bahasa
@@ -17,12 +17,12 @@ llvm::Value* Codegen::generateArrayLiteral(const ArrayLiteralExpr* arrayLiteral)
     llvm::ArrayType* arrayType = llvm::ArrayType::get(elementType, size);
     
     // Create alloca for the array
-    llvm::AllocaInst* arrayAlloca = builder->CreateAlloca(arrayType, nullptr, "array");
+    llvm::AllocaInst* arrayAlloca = createEntryAlloca(arrayType, "array");
     
     // Initialize array elements
     for (size_t i = 0; i < size; i++) {
         // Get element value
-        llvm::Value* element = generateExpr(arrayLiteral->elements[i].get());
+        llvm::Value* element = generateExpr(arrayLiteral->elements[i]);
         
         // Create GEP for the index
         std::vector<llvm::Value*> indices = {
@@ -38,40 +38,15 @@ llvm::Value* Codegen::generateArrayLiteral(const ArrayLiteralExpr* arrayLiteral)
     return arrayAlloca;
 }
 
-llvm::Value* Codegen::generateArrayIndex(const ArrayIndexExpr* arrayIndex, llvm::BasicBlock* errorBlock) {
-    // Get the array pointer
-    llvm::Value* arrayPtr = namedValues[arrayIndex->array];
-    if (!arrayPtr) {
-        llvm::report_fatal_error(llvm::Twine("Array tidak ditemukan: ") + arrayIndex->array);
-    }
-    
-    // Get array type
-    llvm::Type* ptrType = arrayPtr->getType();
-    if (!ptrType->isPointerTy()) {
-        llvm::report_fatal_error(llvm::Twine("Variabel bukan pointer: ") + arrayIndex->array);
-    }
-    
-    // Get array size from the alloca instruction
-    llvm::AllocaInst* alloca = llvm::dyn_cast<llvm::AllocaInst>(arrayPtr);
-    if (!alloca) {
-        llvm::report_fatal_error(llvm::Twine("Variabel bukan array: ") + arrayIndex->array);
-    }
-    
-    llvm::ArrayType* arrayType = llvm::dyn_cast<llvm::ArrayType>(alloca->getAllocatedType());
-    if (!arrayType) {
-        llvm::report_fatal_error(llvm::Twine("Variabel bukan array: ") + arrayIndex->array);
-    }
-    
-    // Get array size
-    size_t arraySize = arrayType->getArrayNumElements();
+llvm::Value* Codegen::generateArrayIndex(const ArrayIndexExpr* arrayIndex) {
+    ArrayView array = getArray(arrayIndex->array);
     
-    // Get index value - must be a constant number
-    if (auto numExpr = dynamic_cast<const NumberExpr*>(arrayIndex->index.get())) {
+    // A constant index into a fixed-size array is checked at compile time
+    auto numExpr = llvm::dyn_cast<NumberExpr>(arrayIndex->index);
+    if (array.fixedType && numExpr) {
+        size_t arraySize = array.fixedType->getArrayNumElements();
         if (numExpr->value < 0 || numExpr->value >= arraySize) {
-            // Branch to error block if it exists
-            if (errorBlock) {
-                builder->CreateBr(errorBlock);
-            }
+            failCheck();
             return llvm::ConstantInt::get(getIntType(), 0);
         }
         
@@ -84,14 +59,13 @@ llvm::Value* Codegen::generateArrayIndex(const ArrayIndexExpr* arrayIndex, llvm:
         };
         
         // Create GEP instruction
-        llvm::Value* elementPtr = builder->CreateGEP(arrayType, arrayPtr, indices, "array.index");
+        llvm::Value* elementPtr = builder->CreateGEP(array.fixedType, array.base, indices, "array.index");
         
         // Load and return the element
-        return builder->CreateLoad(arrayType->getArrayElementType(), elementPtr, "array.load");
+        return builder->CreateLoad(array.fixedType->getArrayElementType(), elementPtr, "array.load");
     }
     
-    llvm::report_fatal_error("Indeks array harus berupa angka konstan");
-    return nullptr;
+    return loadChecked(array, generateExpr(arrayIndex->index));
 }
 
 }
\ No newline at end of file
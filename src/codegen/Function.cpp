@@ -1,4 +1,5 @@
 #include "codegen/Codegen.hpp"
+#include "ast/ASTVisitor.hpp"
 #include <llvm/IR/Verifier.h>
 #include <iostream>
 #include <llvm/MC/TargetRegistry.h>
@@ -6,10 +7,31 @@
 
 namespace bahasa {
 
+namespace {
+
+// `<- f(...)` where f is the enclosing function itself, with a full argument list
+bool isSelfTailCall(const ReturnStmt* ret, const FunctionStmt* func) {
+    auto call = llvm::dyn_cast<CallExpr>(ret->value);
+    return call && call->callee == func->name && call->arguments.size() == func->params.size();
+}
+
+struct SelfTailCalls : RecursiveVisitor<SelfTailCalls> {
+    const FunctionStmt* func;
+    bool found = false;
+
+    explicit SelfTailCalls(const FunctionStmt* func) : func(func) {}
+
+    void visitReturn(const ReturnStmt* ret) {
+        found |= isSelfTailCall(ret, func);
+    }
+};
+
+} // namespace
+
 void Codegen::generateFunction(const FunctionStmt* func) {
-    llvm::Function* function = functions[func->name];
+    llvm::Function* function = functions.lookup(func->name.id());
     if (!function) {
-        llvm::report_fatal_error(llvm::Twine("Function not found: ") + func->name);
+        throw std::runtime_error("Function not found: " + func->name.str());
     }
     
     // Create entry block
@@ -18,80 +40,130 @@ void Codegen::generateFunction(const FunctionStmt* func) {
     
     // Clear named values and add parameters
     namedValues.clear();
-    for (auto& arg : function->args()) {
-        namedValues[std::string(arg.getName())] = &arg;
-    }
+    currentFunctionName = func->name;
+    tailRecursionHeader = nullptr;
+    tailRecursionParams.clear();
+    loops.clear();
+    heapArrays.clear();
+    errorTarget = nullptr;
+    coldBlocks.clear();
     
-    // Generate function body
-    for (const auto& stmt : func->body) {
-        if (auto ret = std::dynamic_pointer_cast<ReturnStmt>(stmt)) {
-            generateReturn(ret.get(), function);
-        }
-        else if (auto var = std::dynamic_pointer_cast<VarDeclStmt>(stmt)) {
-            generateVarDecl(var.get(), function);
-        }
-        else if (auto ifStmt = std::dynamic_pointer_cast<IfStmt>(stmt)) {
-            generateIf(ifStmt.get(), function);
-        }
-        else if (auto tryStmt = std::dynamic_pointer_cast<TryStmt>(stmt)) {
-            generateTryBlock(tryStmt.get(), function);
+    SelfTailCalls selfCalls(func);
+    selfCalls.visitAll(func->body);
+    if (selfCalls.found) {
+        // The body becomes a loop: entry only holds the stack slots and falls
+        // through to the header, which every self tail call jumps back to
+        tailRecursionHeader = llvm::BasicBlock::Create(*context, "tailrecurse", function);
+        builder->CreateBr(tailRecursionHeader);
+        builder->SetInsertPoint(tailRecursionHeader);
+        for (size_t i = 0; i < func->params.size(); i++) {
+            llvm::PHINode* param = builder->CreatePHI(getIntType(), 2, func->params[i].name.view());
+            param->addIncoming(function->getArg(i), bb);
+            tailRecursionParams.push_back(param);
+            namedValues[func->params[i].name.id()] = param;
         }
-        else if (auto exprStmt = std::dynamic_pointer_cast<ExprStmt>(stmt)) {
-            generateExprStmt(exprStmt.get(), function);
+    } else {
+        for (size_t i = 0; i < func->params.size(); i++) {
+            namedValues[func->params[i].name.id()] = function->getArg(i);
         }
     }
     
+    // Generate function body
+    generateBlock(func->body, function);
+    freeHeapArrays(function);
+    for (llvm::BasicBlock* block : coldBlocks) {
+        block->moveAfter(&function->back());
+    }
+    
     // Verify function
     llvm::verifyFunction(*function);
 }
 
 void Codegen::generateReturn(const ReturnStmt* ret, llvm::Function* currentFunction) {
-    llvm::Value* returnValue = generateExpr(ret->value.get());
+    auto call = llvm::dyn_cast<CallExpr>(ret->value);
+    if (tailRecursionHeader && call && call->callee == currentFunctionName &&
+        call->arguments.size() == tailRecursionParams.size()) {
+        // Evaluate every argument before any parameter takes its new value
+        llvm::SmallVector<llvm::Value*, 4> arguments;
+        for (const Expr* arg : call->arguments) {
+            arguments.push_back(generateExpr(arg));
+        }
+        llvm::BasicBlock* from = builder->GetInsertBlock();
+        for (size_t i = 0; i < arguments.size(); i++) {
+            tailRecursionParams[i]->addIncoming(arguments[i], from);
+        }
+        builder->CreateBr(tailRecursionHeader);
+        return;
+    }
+    
+    llvm::Value* returnValue = generateExpr(ret->value);
+    
+    // Any other user function whose result is returned directly: musttail
+    // guarantees no stack growth when the prototypes match, otherwise it is a
+    // hint. Only user functions qualify, since their parameters are all i32
+    // and so can never point into this frame; builtins may take pointers to
+    // the caller's koleksi and stay plain calls.
+    bool userCall = call && prototypes && prototypes->count(call->callee.id());
+    auto callInst = userCall ? llvm::dyn_cast<llvm::CallInst>(returnValue) : nullptr;
+    if (callInst) {
+        llvm::Function* callee = callInst->getCalledFunction();
+        bool sameShape = callee && callee->getFunctionType() == currentFunction->getFunctionType() &&
+                         callee->getCallingConv() == currentFunction->getCallingConv();
+        callInst->setTailCallKind(sameShape ? llvm::CallInst::TCK_MustTail : llvm::CallInst::TCK_Tail);
+    }
     builder->CreateRet(returnValue);
 }
 
 
 llvm::Value* Codegen::generateCall(const CallExpr* call) {
-    llvm::Function* callee = functions[call->callee];
+    llvm::Function* callee = getFunction(call->callee);
+    // A user function of the same name takes precedence
+    if (!callee && call->callee == lengthSymbol) {
+        return generateLength(call);
+    }
     if (!callee) {
-        llvm::report_fatal_error(llvm::Twine("Fungsi tidak dikenal: ") + call->callee);
+        throw std::runtime_error("Fungsi tidak dikenal: " + call->callee.str());
     }
     
     std::vector<llvm::Value*> argsV;
-    if (callee->getName() == "tampilkan") {
+    if (call->callee == printSymbol) {
         if (call->arguments.size() < 2) {
-            llvm::report_fatal_error("tampilkan membutuhkan minimal 2 argumen: string format dan nilai");
+            throw std::runtime_error("tampilkan membutuhkan minimal 2 argumen: string format dan nilai");
         }
         
         // First argument should be format string
-        if (auto formatStr = std::dynamic_pointer_cast<StringExpr>(call->arguments[0])) {
+        if (auto formatStr = llvm::dyn_cast<StringExpr>(call->arguments[0])) {
             argsV.push_back(getStringConstant(formatStr->value));
         } else {
-            llvm::report_fatal_error("Argumen pertama tampilkan harus berupa string format");
+            throw std::runtime_error("Argumen pertama tampilkan harus berupa string format");
         }
         
         // Second argument should be string or value
-        if (auto strArg = std::dynamic_pointer_cast<StringExpr>(call->arguments[1])) {
+        if (auto strArg = llvm::dyn_cast<StringExpr>(call->arguments[1])) {
             argsV.push_back(getStringConstant(strArg->value));
         } else {
-            argsV.push_back(generateExpr(call->arguments[1].get()));
+            argsV.push_back(generateExpr(call->arguments[1]));
         }
         
         builder->CreateCall(callee, argsV);
         return llvm::ConstantInt::get(getIntType(), 0); // Return dummy value
     }
-    else if (callee->getName() == "tidur") {
+    else if (call->callee == sleepSymbol) {
         if (call->arguments.size() < 1) {
-            llvm::report_fatal_error("tidur membutuhkan minimal 1 argumen: integer");
+            throw std::runtime_error("tidur membutuhkan minimal 1 argumen: integer");
         }
-        argsV.push_back(generateExpr(call->arguments[0].get()));
+        argsV.push_back(generateExpr(call->arguments[0]));
         builder->CreateCall(callee, argsV);
         return llvm::ConstantInt::get(getIntType(), 0); // Return dummy value
     }
     
+    else if (llvm::is_contained(reduceSymbols, call->callee) && !prototypes->count(call->callee.id())) {
+        return generateReduceCall(call, callee);
+    }
+    
     // Handle normal function calls
     for (const auto& arg : call->arguments) {
-        argsV.push_back(generateExpr(arg.get()));
+        argsV.push_back(generateExpr(arg));
     }
     return builder->CreateCall(callee, argsV, "calltmp");
 }
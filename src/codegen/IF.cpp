@@ -8,7 +8,7 @@ namespace bahasa {
 
 
 void Codegen::generateIf(const IfStmt* ifStmt, llvm::Function* currentFunction) {
-    llvm::Value* condValue = generateExpr(ifStmt->condition.get());
+    llvm::Value* condValue = generateExpr(ifStmt->condition);
     
     // Convert condition to bool
     condValue = builder->CreateICmpNE(
@@ -27,17 +27,7 @@ void Codegen::generateIf(const IfStmt* ifStmt, llvm::Function* currentFunction)
     builder->SetInsertPoint(thenBB);
     
     // Generate code for all statements in the then block
-    for (const auto& stmt : ifStmt->thenBranch) {
-        if (auto ret = std::dynamic_pointer_cast<ReturnStmt>(stmt)) {
-            generateReturn(ret.get(), currentFunction);
-        }
-        else if (auto var = std::dynamic_pointer_cast<VarDeclStmt>(stmt)) {
-            generateVarDecl(var.get(), currentFunction);
-        }
-        else if (auto exprStmt = std::dynamic_pointer_cast<ExprStmt>(stmt)) {
-            generateExprStmt(exprStmt.get(), currentFunction);
-        }
-    }
+    generateBlock(ifStmt->thenBranch, currentFunction);
     
     // Create branch to merge block if there's no terminator
     if (!builder->GetInsertBlock()->getTerminator()) {
@@ -0,0 +1,102 @@
+#include "codegen/Codegen.hpp"
+
+namespace bahasa {
+
+// Both forms of selama get the canonical shape loop passes expect without
+// having to rebuild it: a preheader that only enters the loop, a header
+// holding the exit test, the body, one latch carrying the single back edge,
+// and an exit block reached only from inside the loop.
+
+void Codegen::generateLoopBody(llvm::ArrayRef<StmtPtr> body, llvm::BasicBlock* latch,
+                               llvm::BasicBlock* exit, llvm::Function* currentFunction) {
+    loops.push_back({latch, exit});
+    generateBlock(body, currentFunction);
+    loops.pop_back();
+
+    if (!builder->GetInsertBlock()->getTerminator()) {
+        builder->CreateBr(latch);
+    }
+}
+
+void Codegen::generateWhile(const WhileStmt* whileStmt, llvm::Function* currentFunction) {
+    llvm::BasicBlock* preheader = llvm::BasicBlock::Create(*context, "loop.preheader", currentFunction);
+    llvm::BasicBlock* header = llvm::BasicBlock::Create(*context, "loop.header", currentFunction);
+    llvm::BasicBlock* body = llvm::BasicBlock::Create(*context, "loop.body", currentFunction);
+    llvm::BasicBlock* latch = llvm::BasicBlock::Create(*context, "loop.latch", currentFunction);
+    llvm::BasicBlock* exit = llvm::BasicBlock::Create(*context, "loop.exit", currentFunction);
+
+    builder->CreateBr(preheader);
+    builder->SetInsertPoint(preheader);
+    builder->CreateBr(header);
+
+    // The condition is evaluated again on every iteration
+    builder->SetInsertPoint(header);
+    llvm::Value* condValue = builder->CreateICmpNE(
+        generateExpr(whileStmt->condition),
+        llvm::ConstantInt::get(getIntType(), 0),
+        "loopcond"
+    );
+    builder->CreateCondBr(condValue, body, exit);
+
+    builder->SetInsertPoint(body);
+    generateLoopBody(whileStmt->body, latch, exit, currentFunction);
+
+    builder->SetInsertPoint(latch);
+    builder->CreateBr(header);
+
+    builder->SetInsertPoint(exit);
+}
+
+void Codegen::generateForEach(const ForEachStmt* forEach, llvm::Function* currentFunction) {
+    ArrayView array = getArray(forEach->array);
+
+    // The element is an ordinary variable the body may read or assign
+    llvm::AllocaInst* element = createEntryAlloca(getIntType(), forEach->element.view());
+    namedValues[forEach->element.id()] = element;
+
+    llvm::BasicBlock* preheader = llvm::BasicBlock::Create(*context, "loop.preheader", currentFunction);
+    llvm::BasicBlock* header = llvm::BasicBlock::Create(*context, "loop.header", currentFunction);
+    llvm::BasicBlock* body = llvm::BasicBlock::Create(*context, "loop.body", currentFunction);
+    llvm::BasicBlock* latch = llvm::BasicBlock::Create(*context, "loop.latch", currentFunction);
+    llvm::BasicBlock* exit = llvm::BasicBlock::Create(*context, "loop.exit", currentFunction);
+
+    builder->CreateBr(preheader);
+    builder->SetInsertPoint(preheader);
+    builder->CreateBr(header);
+
+    // Counted from 0 to the length read before the loop, so the trip count
+    // is known on entry and every access in bounds
+    builder->SetInsertPoint(header);
+    llvm::PHINode* index = builder->CreatePHI(getIntType(), 2, "loop.index");
+    index->addIncoming(llvm::ConstantInt::get(getIntType(), 0), preheader);
+    builder->CreateCondBr(builder->CreateICmpULT(index, array.length, "loopcond"), body, exit);
+
+    builder->SetInsertPoint(body);
+    llvm::Value* elementPtr = elementPointer(array, index);
+    builder->CreateStore(builder->CreateLoad(getIntType(), elementPtr, "array.load"), element);
+    generateLoopBody(forEach->body, latch, exit, currentFunction);
+
+    builder->SetInsertPoint(latch);
+    llvm::Value* next = builder->CreateAdd(index, llvm::ConstantInt::get(getIntType(), 1),
+                                           "loop.next", /*HasNUW=*/true, /*HasNSW=*/true);
+    index->addIncoming(next, latch);
+    builder->CreateBr(header);
+
+    builder->SetInsertPoint(exit);
+}
+
+void Codegen::generateBreak(const BreakStmt*, llvm::Function*) {
+    if (loops.empty()) {
+        throw std::runtime_error("berhenti hanya dapat dipakai di dalam selama");
+    }
+    builder->CreateBr(loops.back().exit);
+}
+
+void Codegen::generateContinue(const ContinueStmt*, llvm::Function*) {
+    if (loops.empty()) {
+        throw std::runtime_error("lanjut hanya dapat dipakai di dalam selama");
+    }
+    builder->CreateBr(loops.back().latch);
+}
+
+}
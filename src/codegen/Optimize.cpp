@@ -0,0 +1,52 @@
+#include "codegen/Codegen.hpp"
+#include <llvm/IR/PassTimingInfo.h>
+#include <llvm/Passes/PassBuilder.h>
+
+namespace bahasa {
+
+void Codegen::optimize(OptLevel level, llvm::TargetMachine* targetMachine, llvm::raw_ostream* passTimings) {
+    llvm::PassInstrumentationCallbacks instrumentation;
+    llvm::TimePassesHandler timePasses(passTimings != nullptr);
+    if (passTimings) {
+        timePasses.setOutStream(*passTimings);
+        timePasses.registerCallbacks(instrumentation);
+    }
+
+    llvm::LoopAnalysisManager loopAM;
+    llvm::FunctionAnalysisManager functionAM;
+    llvm::CGSCCAnalysisManager cgsccAM;
+    llvm::ModuleAnalysisManager moduleAM;
+
+    llvm::PassBuilder passBuilder(targetMachine, llvm::PipelineTuningOptions(), llvm::None, &instrumentation);
+    passBuilder.registerModuleAnalyses(moduleAM);
+    passBuilder.registerCGSCCAnalyses(cgsccAM);
+    passBuilder.registerFunctionAnalyses(functionAM);
+    passBuilder.registerLoopAnalyses(loopAM);
+    passBuilder.crossRegisterProxies(loopAM, functionAM, cgsccAM, moduleAM);
+
+    llvm::ModulePassManager modulePM;
+    switch (level) {
+        case OptLevel::O0:
+            modulePM = passBuilder.buildO0DefaultPipeline(llvm::OptimizationLevel::O0);
+            break;
+        case OptLevel::O1:
+            modulePM = passBuilder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O1);
+            break;
+        case OptLevel::O2:
+            modulePM = passBuilder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+            break;
+        case OptLevel::O3:
+            modulePM = passBuilder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3);
+            break;
+        case OptLevel::Os:
+            modulePM = passBuilder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::Os);
+            break;
+    }
+    modulePM.run(*module, moduleAM);
+
+    if (passTimings) {
+        timePasses.print();
+    }
+}
+
+} // namespace bahasa
@@ -13,33 +13,23 @@ void Codegen::generateTryBlock(const TryStmt* tryStmt, llvm::Function* currentFu
     llvm::BasicBlock* tryBlock = llvm::BasicBlock::Create(*context, "try", currentFunction);
     llvm::BasicBlock* errorBlock = llvm::BasicBlock::Create(*context, "error", currentFunction);
     llvm::BasicBlock* continueBlock = llvm::BasicBlock::Create(*context, "try_continue", currentFunction);
+    coldBlocks.push_back(errorBlock);
     
     // Branch to try block
     builder->CreateBr(tryBlock);
     
-    // Generate try block
+    // Generate try block. Every check in it, however deep in an expression,
+    // fails to the error block; an inner abaikan catches its own
     builder->SetInsertPoint(tryBlock);
-    for (const auto& stmt : tryStmt->tryBlock) {
-        if (auto ret = std::dynamic_pointer_cast<ReturnStmt>(stmt)) {
-            generateReturn(ret.get(), currentFunction);
-        }
-        else if (auto var = std::dynamic_pointer_cast<VarDeclStmt>(stmt)) {
-            generateVarDecl(var.get(), currentFunction);
-        }
-        else if (auto ifStmt = std::dynamic_pointer_cast<IfStmt>(stmt)) {
-            generateIf(ifStmt.get(), currentFunction);
-        }
-        else if (auto exprStmt = std::dynamic_pointer_cast<ExprStmt>(stmt)) {
-            if (auto arrayIndex = std::dynamic_pointer_cast<ArrayIndexExpr>(exprStmt->expr)) {
-                generateArrayIndex(arrayIndex.get(), errorBlock);
-            } else {
-                generateExprStmt(exprStmt.get(), currentFunction);
-            }
-        }
-    }
+    llvm::BasicBlock* enclosingTarget = errorTarget;
+    errorTarget = errorBlock;
+    generateBlock(tryStmt->tryBlock, currentFunction);
+    errorTarget = enclosingTarget;
     
     // If we get here, no error occurred, branch to continue block
-    builder->CreateBr(continueBlock);
+    if (!builder->GetInsertBlock()->getTerminator()) {
+        builder->CreateBr(continueBlock);
+    }
     
     // Generate error block (returns 0 and continues)
     builder->SetInsertPoint(errorBlock);
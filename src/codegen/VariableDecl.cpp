@@ -8,51 +8,47 @@ namespace bahasa {
 
 
 llvm::Value* Codegen::generateVariable(const VariableExpr* var) {
-    llvm::Value* value = namedValues[var->name];
+    llvm::Value* value = namedValues.lookup(var->name.id());
     if (!value) {
-        llvm::report_fatal_error(llvm::Twine("Nama variabel tidak dikenal: ") + var->name);
+        throw std::runtime_error("Nama variabel tidak dikenal: " + var->name.str());
     }
     
     // If it's an alloca instruction, load the value
     if (auto alloca = llvm::dyn_cast<llvm::AllocaInst>(value)) {
-        return builder->CreateLoad(getIntType(), alloca, var->name + "_load");
+        return builder->CreateLoad(getIntType(), alloca, llvm::Twine(var->name.view()) + "_load");
     }
     
     return value;
 }
 
 void Codegen::generateVarDecl(const VarDeclStmt* var, llvm::Function* currentFunction) {
-    llvm::Value* value = generateExpr(var->initializer.get());
+    llvm::Value* value = generateExpr(var->initializer);
     
     // If this is an array declaration
     if (value->getType()->isPointerTy()) {
-        namedValues[var->name] = value; // Store the array pointer directly
+        namedValues[var->name.id()] = value; // Store the array pointer directly
         return;
     }
     
-    // Create an alloca instruction in the entry block of the function
-    llvm::IRBuilder<> tempBuilder(&currentFunction->getEntryBlock(), 
-                                 currentFunction->getEntryBlock().begin());
-    
-    // Create alloca for the variable
-    llvm::AllocaInst* alloca = tempBuilder.CreateAlloca(getIntType(), nullptr, var->name);
+    // Create alloca for the variable in the entry block of the function
+    llvm::AllocaInst* alloca = createEntryAlloca(getIntType(), var->name.view());
     
     // Store the initial value
     builder->CreateStore(value, alloca);
     
     // Remember the alloca instruction for this variable
-    namedValues[var->name] = alloca;
+    namedValues[var->name.id()] = alloca;
 }
 
 llvm::Value* Codegen::generateAssignment(const AssignmentExpr* assign) {
     // Get the variable's alloca instruction
-    llvm::Value* variable = namedValues[assign->name];
+    llvm::Value* variable = namedValues.lookup(assign->name.id());
     if (!variable) {
-        llvm::report_fatal_error(llvm::Twine("Variabel tidak ditemukan: ") + assign->name);
+        throw std::runtime_error("Variabel tidak ditemukan: " + assign->name.str());
     }
     
     // Generate the value to assign
-    llvm::Value* value = generateExpr(assign->value.get());
+    llvm::Value* value = generateExpr(assign->value);
     
     // Store the value
     builder->CreateStore(value, variable);
@@ -32,7 +32,7 @@ void Codegen::createPrintFunction() {
     
     llvm::Function* tampilkanFunc = llvm::Function::Create(
         tampilkanType,
-        llvm::Function::ExternalLinkage,
+        llvm::Function::InternalLinkage,  // Every module (codegen shard) has its own copy
         "tampilkan",
         module.get()
     );
@@ -54,6 +54,6 @@ void Codegen::createPrintFunction() {
     
     builder->CreateRetVoid();
     
-    functions["tampilkan"] = tampilkanFunc;
+    functions[printSymbol.id()] = tampilkanFunc;
 }
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "codegen/Codegen.hpp"
+#include <llvm/IR/Intrinsics.h>
+
+namespace bahasa {
+
+namespace {
+
+// Elements per vector iteration. 16 x i32 fills one 512-bit register, or is
+// split into two or four narrower ones acting as independent accumulators
+constexpr unsigned reduceLanes = 16;
+
+} // namespace
+
+// i32 jumlah/minimum/maksimum(i32* data, i32 length) and
+// i32 kali_titik(i32* a, i32* b, i32 length). The body is an explicit loop
+// over <16 x i32> chunks folded across lanes once at the end, followed by a
+// scalar loop over the remaining elements. Both loops are marked vectorized
+// so the loop vectorizer leaves them alone.
+void Codegen::createReduceFunction(Symbol name, Reduction kind) {
+    llvm::Type* intType = getIntType();
+    llvm::Type* intPtrType = intType->getPointerTo();
+    llvm::SmallVector<llvm::Type*, 3> params = {intPtrType};
+    if (kind == Reduction::Dot) {
+        params.push_back(intPtrType);
+    }
+    params.push_back(intType);
+
+    llvm::Function* function = llvm::Function::Create(
+        llvm::FunctionType::get(intType, params, false),
+        llvm::Function::InternalLinkage,  // Private to the module, like tampilkan
+        name.view(),
+        module.get()
+    );
+    function->setOnlyReadsMemory();
+    function->setDoesNotThrow();
+    for (unsigned i = 0; i + 1 < params.size(); i++) {
+        function->addParamAttr(i, llvm::Attribute::NoCapture);
+        function->addParamAttr(i, llvm::Attribute::ReadOnly);
+    }
+
+    llvm::Value* first = function->getArg(0);
+    llvm::Value* second = kind == Reduction::Dot ? function->getArg(1) : nullptr;
+    llvm::Value* length = function->getArg(params.size() - 1);
+
+    llvm::VectorType* vectorType = llvm::FixedVectorType::get(intType, reduceLanes);
+    int32_t identityValue = kind == Reduction::Minimum ? INT32_MAX
+                          : kind == Reduction::Maximum ? INT32_MIN : 0;
+    llvm::Constant* identity = llvm::ConstantInt::get(intType, identityValue, true);
+
+    // One step of the fold, on vectors or scalars alike
+    auto combine = [&](llvm::Value* acc, llvm::Value* value) -> llvm::Value* {
+        switch (kind) {
+            case Reduction::Minimum:
+                return builder->CreateBinaryIntrinsic(llvm::Intrinsic::smin, acc, value);
+            case Reduction::Maximum:
+                return builder->CreateBinaryIntrinsic(llvm::Intrinsic::smax, acc, value);
+            case Reduction::Sum:
+            case Reduction::Dot:
+                break;
+        }
+        return builder->CreateAdd(acc, value);
+    };
+    // The element (or product of elements) at index, `type` wide
+    auto element = [&](llvm::Value* index, llvm::Type* type) -> llvm::Value* {
+        auto load = [&](llvm::Value* base) -> llvm::Value* {
+            llvm::Value* ptr = builder->CreateInBoundsGEP(intType, base, index);
+            if (type != intType) {
+                ptr = builder->CreateBitCast(ptr, type->getPointerTo());
+            }
+            return builder->CreateAlignedLoad(type, ptr, llvm::Align(4));
+        };
+        llvm::Value* value = load(first);
+        return second ? builder->CreateMul(value, load(second)) : value;
+    };
+    llvm::MDNode* vectorized = llvm::MDNode::get(*context, {
+        llvm::MDString::get(*context, "llvm.loop.isvectorized"),
+        llvm::ConstantAsMetadata::get(builder->getInt32(1))
+    });
+    auto markLoop = [&](llvm::Instruction* latchBranch) {
+        llvm::TempMDTuple placeholder = llvm::MDNode::getTemporary(*context, llvm::None);
+        llvm::MDNode* loopID = llvm::MDNode::get(*context, {placeholder.get(), vectorized});
+        loopID->replaceOperandWith(0, loopID);
+        latchBranch->setMetadata(llvm::LLVMContext::MD_loop, loopID);
+    };
+
+    llvm::BasicBlock* entry = llvm::BasicBlock::Create(*context, "entry", function);
+    llvm::BasicBlock* vectorBody = llvm::BasicBlock::Create(*context, "vector.body", function);
+    llvm::BasicBlock* vectorDone = llvm::BasicBlock::Create(*context, "vector.done", function);
+    llvm::BasicBlock* tailBody = llvm::BasicBlock::Create(*context, "tail.body", function);
+    llvm::BasicBlock* exit = llvm::BasicBlock::Create(*context, "exit", function);
+
+    // Lengths are never negative, so masking rounds down to whole vectors
+    builder->SetInsertPoint(entry);
+    llvm::Value* vectorEnd = builder->CreateAnd(length, ~(reduceLanes - 1), "vector.end");
+    builder->CreateCondBr(builder->CreateICmpNE(vectorEnd, builder->getInt32(0)), vectorBody, vectorDone);
+
+    builder->SetInsertPoint(vectorBody);
+    llvm::PHINode* index = builder->CreatePHI(intType, 2, "index");
+    llvm::PHINode* vectorAcc = builder->CreatePHI(vectorType, 2, "vector.acc");
+    index->addIncoming(builder->getInt32(0), entry);
+    vectorAcc->addIncoming(llvm::ConstantVector::getSplat(vectorType->getElementCount(), identity), entry);
+    llvm::Value* nextVectorAcc = combine(vectorAcc, element(index, vectorType));
+    llvm::Value* nextIndex = builder->CreateAdd(index, builder->getInt32(reduceLanes), "index.next",
+                                                /*HasNUW=*/true, /*HasNSW=*/true);
+    index->addIncoming(nextIndex, vectorBody);
+    vectorAcc->addIncoming(nextVectorAcc, vectorBody);
+    markLoop(builder->CreateCondBr(builder->CreateICmpULT(nextIndex, vectorEnd), vectorBody, vectorDone));
+
+    builder->SetInsertPoint(vectorDone);
+    llvm::PHINode* lanes = builder->CreatePHI(vectorType, 2, "lanes");
+    lanes->addIncoming(llvm::ConstantVector::getSplat(vectorType->getElementCount(), identity), entry);
+    lanes->addIncoming(nextVectorAcc, vectorBody);
+    llvm::Value* partial;
+    switch (kind) {
+        case Reduction::Minimum: partial = builder->CreateIntMinReduce(lanes, true); break;
+        case Reduction::Maximum: partial = builder->CreateIntMaxReduce(lanes, true); break;
+        default: partial = builder->CreateAddReduce(lanes); break;
+    }
+    builder->CreateCondBr(builder->CreateICmpULT(vectorEnd, length), tailBody, exit);
+
+    builder->SetInsertPoint(tailBody);
+    llvm::PHINode* tailIndex = builder->CreatePHI(intType, 2, "tail.index");
+    llvm::PHINode* tailAcc = builder->CreatePHI(intType, 2, "tail.acc");
+    tailIndex->addIncoming(vectorEnd, vectorDone);
+    tailAcc->addIncoming(partial, vectorDone);
+    llvm::Value* nextTailAcc = combine(tailAcc, element(tailIndex, intType));
+    llvm::Value* nextTailIndex = builder->CreateAdd(tailIndex, builder->getInt32(1), "tail.next",
+                                                    /*HasNUW=*/true, /*HasNSW=*/true);
+    tailIndex->addIncoming(nextTailIndex, tailBody);
+    tailAcc->addIncoming(nextTailAcc, tailBody);
+    markLoop(builder->CreateCondBr(builder->CreateICmpULT(nextTailIndex, length), tailBody, exit));
+
+    builder->SetInsertPoint(exit);
+    llvm::PHINode* result = builder->CreatePHI(intType, 2, "result");
+    result->addIncoming(partial, vectorDone);
+    result->addIncoming(nextTailAcc, tailBody);
+    if (kind == Reduction::Minimum || kind == Reduction::Maximum) {
+        // The extreme of an empty koleksi is 0, not the identity
+        builder->CreateRet(builder->CreateSelect(
+            builder->CreateICmpEQ(length, builder->getInt32(0)), builder->getInt32(0), result));
+    } else {
+        builder->CreateRet(result);
+    }
+
+    functions[name.id()] = function;
+}
+
+llvm::Value* Codegen::generateReduceCall(const CallExpr* call, llvm::Function* callee) {
+    size_t arrays = callee->arg_size() - 1;
+    if (call->arguments.size() != arrays) {
+        throw std::runtime_error(call->callee.str() + " membutuhkan " + std::to_string(arrays) +
+                                 " argumen: nama koleksi");
+    }
+
+    std::vector<llvm::Value*> args;
+    llvm::Value* length = nullptr;
+    for (const Expr* arg : call->arguments) {
+        auto var = llvm::dyn_cast<VariableExpr>(arg);
+        if (!var) {
+            throw std::runtime_error("Argumen " + call->callee.str() + " harus berupa nama koleksi");
+        }
+        ArrayView array = getArray(var->name);
+        args.push_back(array.fixedType
+            ? builder->CreateConstInBoundsGEP2_32(array.fixedType, array.base, 0, 0, "array.data")
+            : array.base);
+        // kali_titik covers the shorter of its two koleksi
+        length = length ? builder->CreateSelect(builder->CreateICmpULT(length, array.length), length, array.length)
+                        : array.length;
+    }
+    args.push_back(length);
+    // The koleksi may live in the caller's frame, which a tail call would free first
+    llvm::CallInst* result = builder->CreateCall(callee, args, "calltmp");
+    result->setTailCallKind(llvm::CallInst::TCK_NoTail);
+    return result;
+}
+
+}
@@ -33,7 +33,7 @@ void Codegen::createTidurFunction() {
     
     llvm::Function* tidurFunc = llvm::Function::Create(
         tidurType,
-        llvm::Function::ExternalLinkage,
+        llvm::Function::InternalLinkage,  // Private to the module, like tampilkan
         "tidur",
         module.get()
     );
@@ -53,6 +53,6 @@ void Codegen::createTidurFunction() {
 
     builder->CreateRetVoid();
     
-    functions["tidur"] = tidurFunc;
+    functions[sleepSymbol.id()] = tidurFunc;
 }
 }
\ No newline at end of file
@@ -0,0 +1,562 @@
+#include "Compiler.hpp"
+#include "parser/Lexer.hpp"
+#include "parser/Parser.hpp"
+#include "parser/Source.hpp"
+#include "backend/JIT.hpp"
+#include "backend/ObjectEmitter.hpp"
+#include "backend/Cache.hpp"
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Object/Archive.h>
+#include <llvm/Object/ArchiveWriter.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <sstream>
+#include <unistd.h> // For mkstemp
+
+namespace bahasa {
+
+static void writeFile(llvm::StringRef contents, const std::string& outputPath) {
+    std::error_code ec;
+    llvm::raw_fd_ostream out(outputPath, ec, llvm::sys::fs::OF_None);
+    if (ec) {
+        throw std::runtime_error("Tidak dapat membuka berkas keluaran: " + outputPath);
+    }
+    out << contents;
+}
+
+// Write a cached executable to its destination and mark it runnable
+void writeExecutable(llvm::StringRef contents, const std::string& outputPath) {
+    writeFile(contents, outputPath);
+    llvm::sys::fs::setPermissions(outputPath, llvm::sys::fs::all_read | llvm::sys::fs::all_exe |
+                                              llvm::sys::fs::owner_write);
+}
+
+// Helper function to create temporary file
+std::string createTempFile(const std::string& suffix) {
+    char tempPath[] = "bahasa_XXXXXX";
+    int fd = mkstemp(tempPath);
+    if (fd == -1) {
+        throw std::runtime_error("Gagal membuat berkas sementara");
+    }
+    close(fd);
+    
+    // If there's a suffix, rename the file
+    std::string finalPath = tempPath + suffix;
+    if (suffix.length() > 0) {
+        if (rename(tempPath, finalPath.c_str()) != 0) {
+            std::remove(tempPath);
+            throw std::runtime_error("Gagal mengubah nama berkas sementara");
+        }
+    }
+    
+    return finalPath;
+}
+
+// Instruction selection and register allocation effort for -O: -O0 gets the
+// fast paths, which matters most when many small modules are emitted
+static llvm::CodeGenOpt::Level codegenLevel(OptLevel level) {
+    switch (level) {
+        case OptLevel::O0: return llvm::CodeGenOpt::None;
+        case OptLevel::O1: return llvm::CodeGenOpt::Less;
+        case OptLevel::O3: return llvm::CodeGenOpt::Aggressive;
+        case OptLevel::O2:
+        case OptLevel::Os: break;
+    }
+    return llvm::CodeGenOpt::Default;
+}
+
+static SourceBuffer loadSource(const std::string& sourcePath, const CompileOptions& options) {
+    TimingReport::Scope timer(options.timings, "baca sumber");
+    return options.sourceText ? SourceBuffer::fromString(*options.sourceText, sourcePath)
+                              : SourceBuffer::fromFile(sourcePath);
+}
+
+static std::string cacheKey(std::string_view source, llvm::StringRef kind,
+                            const CompileOptions& options, const ObjectEmitter& emitter) {
+    return CompilationCache::makeKey(source, kind, static_cast<int>(options.optLevel),
+                                     emitter.getTargetMachine().getTargetTriple().str());
+}
+
+// Split programs with at least this many functions per shard across threads
+static constexpr size_t minShardFunctions = 128;
+
+// Front end: tokens view into `source` and the lexer, both alive until parsing is done
+static Program parseSource(std::string_view source, const CompileOptions& options) {
+    Lexer lexer(source);
+    std::vector<Token> tokens;
+    {
+        TimingReport::Scope timer(options.timings, "lexer");
+        tokens = lexer.tokenizeParallel(options.threads);
+    }
+    
+    TimingReport::Scope timer(options.timings, "parser");
+    Parser parser(std::move(tokens));
+    return parser.parseParallel(options.threads);
+}
+
+// IR generation and optimization for the host target
+static std::unique_ptr<Codegen> generateModule(const Program& program, const ObjectEmitter& emitter,
+                                               const CompileOptions& options) {
+    std::unique_ptr<Codegen> codegen;
+    {
+        TimingReport::Scope timer(options.timings, "codegen");
+        codegen = std::make_unique<Codegen>(program.moduleName);
+        codegen->generate(program.statements);
+    }
+    
+    {
+        TimingReport::Scope timer(options.timings, "optimasi");
+        emitter.prepare(codegen->getModule());
+        if (options.timings) {
+            llvm::raw_string_ostream passTimings(options.timings->passTimings);
+            codegen->optimize(options.optLevel, &emitter.getTargetMachine(), &passTimings);
+        } else {
+            codegen->optimize(options.optLevel, &emitter.getTargetMachine());
+        }
+    }
+    return codegen;
+}
+
+// Number of codegen shards: one per worker, as long as each gets enough functions
+static unsigned shardCount(const Program& program, const CompileOptions& options) {
+    size_t functions = std::count_if(program.statements.begin(), program.statements.end(),
+                                     [](const Stmt* stmt) { return llvm::isa<FunctionStmt>(stmt); });
+    unsigned workers = llvm::hardware_concurrency(options.threads).compute_thread_count();
+    return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(workers, functions / minShardFunctions)));
+}
+
+// Run task(i) for every shard on `pool`; the first failing shard in source order reports its error
+template <typename Task>
+static void runShards(llvm::ThreadPool& pool, unsigned count, Task task) {
+    std::vector<std::string> errors(count);
+    std::vector<char> failed(count, 0);
+    for (unsigned i = 0; i < count; i++) {
+        pool.async([&, i] {
+            try {
+                task(i);
+            } catch (const std::exception& e) {
+                errors[i] = e.what();
+                failed[i] = 1;
+            }
+        });
+    }
+    pool.wait();
+    for (unsigned i = 0; i < count; i++) {
+        if (failed[i]) {
+            throw std::runtime_error(errors[i]);
+        }
+    }
+}
+
+// Object code for the program in `count` shards, each generated, optimized and
+// emitted on its own thread with its own context and target machine
+static std::vector<std::unique_ptr<llvm::MemoryBuffer>> emitShards(const Program& program, unsigned count,
+                                                                   const CompileOptions& options) {
+    std::vector<std::unique_ptr<ObjectEmitter>> emitters;
+    std::vector<std::unique_ptr<Codegen>> codegens(count);
+    std::vector<std::string> passTimings(count);
+    std::vector<std::unique_ptr<llvm::MemoryBuffer>> objects(count);
+    for (unsigned i = 0; i < count; i++) {
+        emitters.push_back(std::make_unique<ObjectEmitter>(codegenLevel(options.optLevel)));
+    }
+    llvm::ThreadPool pool(llvm::hardware_concurrency(options.threads));
+    
+    {
+        TimingReport::Scope timer(options.timings, "codegen");
+        runShards(pool, count, [&](unsigned i) {
+            codegens[i] = std::make_unique<Codegen>(program.moduleName);
+            codegens[i]->generate(program.statements, i, count);
+        });
+    }
+    {
+        TimingReport::Scope timer(options.timings, "optimasi");
+        runShards(pool, count, [&](unsigned i) {
+            emitters[i]->prepare(codegens[i]->getModule());
+            if (options.timings) {
+                llvm::raw_string_ostream out(passTimings[i]);
+                codegens[i]->optimize(options.optLevel, &emitters[i]->getTargetMachine(), &out);
+            } else {
+                codegens[i]->optimize(options.optLevel, &emitters[i]->getTargetMachine());
+            }
+        });
+        if (options.timings) {
+            for (const auto& text : passTimings) {
+                options.timings->passTimings += text;
+            }
+        }
+    }
+    {
+        TimingReport::Scope timer(options.timings, "objek");
+        runShards(pool, count, [&](unsigned i) {
+            llvm::SmallVector<char, 0> object;
+            llvm::raw_svector_ostream objectStream(object);
+            emitters[i]->emit(codegens[i]->getModule(), objectStream);
+            objects[i] = llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef(object.data(), object.size()));
+        });
+    }
+    return objects;
+}
+
+// Object code for the source, served from the cache when possible. With
+// allowShards a large program may come back as an archive of shard objects.
+static std::unique_ptr<llvm::MemoryBuffer> buildObject(std::string_view source, const ObjectEmitter& emitter,
+                                                       const CompileOptions& options, bool allowShards = false) {
+    std::unique_ptr<CompilationCache> cache;
+    std::string key;
+    if (options.useCache) {
+        cache = std::make_unique<CompilationCache>();
+        key = cacheKey(source, "objek", options, emitter);
+        TimingReport::Scope timer(options.timings, "cache");
+        if (auto cached = cache->lookup(key)) {
+            return cached;
+        }
+    }
+    
+    Program program = parseSource(source, options);
+    unsigned shards = allowShards ? shardCount(program, options) : 1;
+    std::unique_ptr<llvm::MemoryBuffer> result;
+    if (shards > 1) {
+        auto objects = emitShards(program, shards, options);
+        std::vector<llvm::NewArchiveMember> members;
+        for (unsigned i = 0; i < shards; i++) {
+            members.emplace_back(llvm::MemoryBufferRef(objects[i]->getBuffer(), "shard" + std::to_string(i) + ".o"));
+        }
+        auto archive = llvm::writeArchiveToBuffer(members, /*WriteSymtab=*/true, llvm::object::Archive::K_GNU,
+                                                  /*Deterministic=*/true, /*Thin=*/false);
+        if (!archive) {
+            throw std::runtime_error("Gagal membuat arsip objek: " + llvm::toString(archive.takeError()));
+        }
+        result = std::move(*archive);
+    } else {
+        auto codegen = generateModule(program, emitter, options);
+        llvm::SmallVector<char, 0> object;
+        {
+            TimingReport::Scope timer(options.timings, "objek");
+            llvm::raw_svector_ostream objectStream(object);
+            emitter.emit(codegen->getModule(), objectStream);
+        }
+        result = llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef(object.data(), object.size()));
+    }
+    
+    if (cache) {
+        cache->insert(key, result->getBuffer());
+    }
+    return result;
+}
+
+// Incremental susun: every function is compiled to an object of its own and
+// kept between builds in an archive (one per source path), the member named
+// by the hash of the function's fingerprint. A rebuild reuses the members
+// whose name is still wanted and only generates the functions that changed.
+static std::unique_ptr<llvm::MemoryBuffer> buildIncremental(const Program& program, const std::string& sourcePath,
+                                                            const ObjectEmitter& emitter, CompilationCache& cache,
+                                                            const CompileOptions& options) {
+    FunctionTable table;
+    std::vector<const FunctionStmt*> functions;
+    for (const Stmt* stmt : program.statements) {
+        if (auto func = llvm::dyn_cast<FunctionStmt>(stmt)) {
+            functions.push_back(func);
+            table[func->name.id()] = func;
+        }
+    }
+    
+    int optLevel = static_cast<int>(options.optLevel);
+    std::string triple = emitter.getTargetMachine().getTargetTriple().str();
+    std::vector<std::string> names(functions.size());
+    {
+        TimingReport::Scope timer(options.timings, "sidik jari");
+        for (size_t i = 0; i < functions.size(); i++) {
+            std::string fingerprint = program.moduleName + ";" + Codegen::fingerprint(functions[i], table);
+            names[i] = CompilationCache::makeKey(fingerprint, "fungsi", optLevel, triple) + ".o";
+        }
+    }
+    
+    // Members of the previous build, if any; `previous` backs them until the new archive is written
+    llvm::SmallString<128> absolutePath(sourcePath);
+    llvm::sys::fs::make_absolute(absolutePath);
+    std::string stateKey = CompilationCache::makeKey(absolutePath, "inkremental", optLevel, triple);
+    std::unique_ptr<llvm::MemoryBuffer> previous;
+    std::unique_ptr<llvm::object::Archive> previousArchive;
+    llvm::StringMap<llvm::MemoryBufferRef> reusable;
+    {
+        TimingReport::Scope timer(options.timings, "cache fungsi");
+        previous = cache.lookup(stateKey);
+        if (previous) {
+            auto archive = llvm::object::Archive::create(previous->getMemBufferRef());
+            if (archive) {
+                previousArchive = std::move(*archive);
+                llvm::Error err = llvm::Error::success();
+                for (const auto& child : previousArchive->children(err)) {
+                    auto name = child.getName();
+                    auto buffer = child.getMemoryBufferRef();
+                    if (name && buffer) {
+                        reusable[*name] = *buffer;
+                    } else {
+                        llvm::consumeError(name.takeError());
+                        llvm::consumeError(buffer.takeError());
+                    }
+                }
+                llvm::consumeError(std::move(err));
+            } else {
+                llvm::consumeError(archive.takeError());
+            }
+        }
+    }
+    
+    std::vector<size_t> stale;
+    for (size_t i = 0; i < functions.size(); i++) {
+        if (!reusable.count(names[i])) {
+            stale.push_back(i);
+        }
+    }
+    
+    // Changed functions, split into contiguous runs over the workers
+    std::vector<std::unique_ptr<llvm::MemoryBuffer>> built(functions.size());
+    if (!stale.empty()) {
+        TimingReport::Scope timer(options.timings, "susun fungsi");
+        unsigned workers = std::min<size_t>(llvm::hardware_concurrency(options.threads).compute_thread_count(),
+                                            stale.size());
+        std::vector<std::unique_ptr<ObjectEmitter>> emitters;
+        for (unsigned w = 0; w < workers; w++) {
+            emitters.push_back(std::make_unique<ObjectEmitter>(codegenLevel(options.optLevel)));
+        }
+        llvm::ThreadPool pool(llvm::hardware_concurrency(workers));
+        runShards(pool, workers, [&](unsigned w) {
+            for (size_t k = w * stale.size() / workers; k < (w + 1) * stale.size() / workers; k++) {
+                size_t i = stale[k];
+                Codegen codegen(program.moduleName);
+                codegen.generateFunctions(functions[i], table);
+                emitters[w]->prepare(codegen.getModule());
+                codegen.optimize(options.optLevel, &emitters[w]->getTargetMachine());
+                llvm::SmallVector<char, 0> object;
+                llvm::raw_svector_ostream objectStream(object);
+                emitters[w]->emit(codegen.getModule(), objectStream);
+                built[i] = llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef(object.data(), object.size()));
+            }
+        });
+    }
+    
+    TimingReport::Scope timer(options.timings, "arsip");
+    std::vector<llvm::NewArchiveMember> members;
+    for (size_t i = 0; i < functions.size(); i++) {
+        llvm::MemoryBufferRef object = built[i] ? built[i]->getMemBufferRef() : reusable[names[i]];
+        members.emplace_back(llvm::MemoryBufferRef(object.getBuffer(), names[i]));
+    }
+    auto archive = llvm::writeArchiveToBuffer(members, /*WriteSymtab=*/true, llvm::object::Archive::K_GNU,
+                                              /*Deterministic=*/true, /*Thin=*/false);
+    if (!archive) {
+        throw std::runtime_error("Gagal membuat arsip objek: " + llvm::toString(archive.takeError()));
+    }
+    cache.insert(stateKey, (*archive)->getBuffer());
+    return std::move(*archive);
+}
+
+int compileLLVMIR(const std::string& sourcePath, const std::string& outputPath,
+                  const CompileOptions& options, std::ostream& diagnostics, std::string* moduleName) {
+    try {
+        SourceBuffer source = loadSource(sourcePath, options);
+        ObjectEmitter emitter(codegenLevel(options.optLevel));
+        auto codegen = generateModule(parseSource(source.text(), options), emitter, options);
+        
+        std::string name = codegen->getModule().getName().str();
+        if (moduleName) {
+            *moduleName = name;
+        }
+
+        // Determine output file name
+        std::string outFile = outputPath.empty() ? name + (options.bitcode ? ".bc" : ".ll") : outputPath;
+        
+        // Stream straight into the output file instead of buffering the whole module
+        TimingReport::Scope timer(options.timings, "tulis ir");
+        std::error_code ec;
+        llvm::raw_fd_ostream out(outFile, ec, options.bitcode ? llvm::sys::fs::OF_None : llvm::sys::fs::OF_Text);
+        if (ec) {
+            throw std::runtime_error("Tidak dapat membuka berkas keluaran: " + outFile);
+        }
+
+        if (options.bitcode) {
+            codegen->dumpBitcode(out);
+        } else {
+            codegen->dump(out);
+        }
+        
+        //std::cout << "Berhasil dikompilasi ke " << outFile << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        diagnostics << "Galat: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int compileToObject(const std::string& sourcePath, const std::string& outputPath,
+                    const CompileOptions& options, std::ostream& diagnostics) {
+    try {
+        SourceBuffer source = loadSource(sourcePath, options);
+        ObjectEmitter emitter(codegenLevel(options.optLevel));
+        auto object = buildObject(source.text(), emitter, options);
+        
+        std::error_code ec;
+        llvm::raw_fd_ostream out(outputPath, ec, llvm::sys::fs::OF_None);
+        if (ec) {
+            throw std::runtime_error("Tidak dapat membuka berkas keluaran: " + outputPath);
+        }
+        out << object->getBuffer();
+        return 0;
+        
+    } catch (const std::exception& e) {
+        diagnostics << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int compileToExecutable(const std::string& sourcePath, const std::string& outputPath,
+                        const CompileOptions& options, std::ostream& diagnostics) {
+    std::vector<std::string> tempObjects;
+    try {
+        SourceBuffer source = loadSource(sourcePath, options);
+        ObjectEmitter emitter(codegenLevel(options.optLevel));
+        
+        // A cache hit skips the whole pipeline, including the link
+        std::unique_ptr<CompilationCache> cache;
+        std::string key;
+        if (options.useCache) {
+            cache = std::make_unique<CompilationCache>();
+            key = cacheKey(source.text(), "susun", options, emitter);
+            TimingReport::Scope timer(options.timings, "cache");
+            if (auto cached = cache->lookup(key)) {
+                writeExecutable(cached->getBuffer(), outputPath);
+                return 0;
+            }
+        }
+        
+        Program program = parseSource(source.text(), options);
+        unsigned shards = shardCount(program, options);
+        
+        // Emit the object files in-process, only linking needs an external tool
+        if (options.incremental && cache) {
+            auto archive = buildIncremental(program, sourcePath, emitter, *cache, options);
+            tempObjects.push_back(createTempFile(".a"));
+            writeFile(archive->getBuffer(), tempObjects.back());
+        } else if (shards > 1) {
+            auto objects = emitShards(program, shards, options);
+            for (const auto& object : objects) {
+                tempObjects.push_back(createTempFile(".o"));
+                writeFile(object->getBuffer(), tempObjects.back());
+            }
+        } else {
+            auto codegen = generateModule(program, emitter, options);
+            tempObjects.push_back(createTempFile(".o"));
+            TimingReport::Scope timer(options.timings, "objek");
+            emitter.emit(codegen->getModule(), tempObjects.back());
+        }
+        {
+            TimingReport::Scope timer(options.timings, "tautkan");
+            linkExecutable(tempObjects, outputPath);
+        }
+        
+        // Clean up temporary files
+        for (const auto& path : tempObjects) {
+            std::remove(path.c_str());
+        }
+        
+        if (cache) {
+            if (auto built = llvm::MemoryBuffer::getFile(outputPath, /*IsText=*/false, /*RequiresNullTerminator=*/false)) {
+                cache->insert(key, (*built)->getBuffer());
+            }
+        }
+        
+        //std::cout << "Successfully compiled to " << outputPath << std::endl;
+        return 0;
+        
+    } catch (const std::exception& e) {
+        for (const auto& path : tempObjects) {
+            std::remove(path.c_str());
+        }
+        diagnostics << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int runExecutable(const std::string& sourcePath, const CompileOptions& options, std::ostream& diagnostics) {
+    try {
+        SourceBuffer source = loadSource(sourcePath, options);
+        ObjectEmitter emitter(codegenLevel(options.optLevel));
+        JIT jit;
+        
+        // With the cache enabled the object code is emitted once so it can be both cached and loaded
+        if (options.useCache) {
+            auto object = buildObject(source.text(), emitter, options, /*allowShards=*/true);
+            TimingReport::Scope timer(options.timings, "jit muat");
+            jit.addObject(std::move(object));
+        } else {
+            // Run main in-process instead of linking a temporary executable
+            Program program = parseSource(source.text(), options);
+            unsigned shards = shardCount(program, options);
+            if (shards > 1) {
+                auto objects = emitShards(program, shards, options);
+                TimingReport::Scope timer(options.timings, "jit muat");
+                for (auto& object : objects) {
+                    jit.addObject(std::move(object));
+                }
+            } else {
+                auto codegen = generateModule(program, emitter, options);
+                TimingReport::Scope timer(options.timings, "jit muat");
+                auto module = codegen->takeModule();
+                jit.addModule(codegen->takeContext(), std::move(module));
+            }
+        }
+        
+        JIT::MainFunction mainFn;
+        {
+            TimingReport::Scope timer(options.timings, "jit");
+            mainFn = jit.lookupMain();
+        }
+        TimingReport::Scope timer(options.timings, "program");
+        return JIT::callMain(mainFn);
+        
+    } catch (const std::exception& e) {
+        diagnostics << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int compileBatch(const std::vector<std::string>& sourcePaths, unsigned jobs,
+                 const std::function<int(const std::string& sourcePath, std::ostream& diagnostics)>& compileOne,
+                 std::ostream& diagnostics) {
+    // Register the native target before any worker builds a TargetMachine
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    std::vector<std::ostringstream> messages(sourcePaths.size());
+    std::vector<int> results(sourcePaths.size(), 0);
+    {
+        llvm::ThreadPool pool(llvm::hardware_concurrency(jobs));
+        for (size_t i = 0; i < sourcePaths.size(); i++) {
+            pool.async([&, i] {
+                results[i] = compileOne(sourcePaths[i], messages[i]);
+            });
+        }
+        pool.wait();
+    }
+
+    int exitCode = 0;
+    for (size_t i = 0; i < sourcePaths.size(); i++) {
+        std::string text = messages[i].str();
+        if (!text.empty()) {
+            diagnostics << sourcePaths[i] << ": " << text;
+        }
+        if (results[i] != 0) {
+            exitCode = 1;
+        }
+    }
+    return exitCode;
+}
+
+} // namespace bahasa
@@ -0,0 +1,49 @@
+#ifndef BAHASA_COMPILER_HPP
+#define BAHASA_COMPILER_HPP
+
+#include "codegen/Codegen.hpp"
+#include "Timing.hpp"
+#include <llvm/ADT/StringRef.h>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace bahasa {
+
+struct CompileOptions {
+    OptLevel optLevel = OptLevel::O0;
+    bool bitcode = false;                   // ir: write .bc instead of .ll
+    bool useCache = true;                   // susun/jalankan: use CompilationCache
+    bool incremental = false;               // susun: only recompile functions that changed (needs the cache)
+    std::optional<std::string> sourceText;  // Source supplied inline instead of read from sourcePath
+    TimingReport* timings = nullptr;        // --waktu: record every phase here
+    unsigned threads = 0;                   // Lexer, parser and codegen threads for large sources (0 = one per core)
+};
+
+void writeExecutable(llvm::StringRef contents, const std::string& outputPath);
+std::string createTempFile(const std::string& suffix);
+
+// Each entry point reports failures on `diagnostics` and returns a process exit code.
+// When outputPath is empty, ir writes <nama_modul>.ll (or .bc); moduleName receives the module name.
+int compileLLVMIR(const std::string& sourcePath, const std::string& outputPath,
+                  const CompileOptions& options, std::ostream& diagnostics = std::cerr,
+                  std::string* moduleName = nullptr);
+int compileToObject(const std::string& sourcePath, const std::string& outputPath,
+                    const CompileOptions& options, std::ostream& diagnostics = std::cerr);
+int compileToExecutable(const std::string& sourcePath, const std::string& outputPath,
+                        const CompileOptions& options, std::ostream& diagnostics = std::cerr);
+int runExecutable(const std::string& sourcePath, const CompileOptions& options,
+                  std::ostream& diagnostics = std::cerr);
+
+// Compile many sources concurrently on `jobs` threads (0 = one per core). Every
+// job builds its own LLVMContext/Codegen; diagnostics are buffered per file and
+// printed in input order. Returns 1 if any job failed.
+int compileBatch(const std::vector<std::string>& sourcePaths, unsigned jobs,
+                 const std::function<int(const std::string& sourcePath, std::ostream& diagnostics)>& compileOne,
+                 std::ostream& diagnostics = std::cerr);
+
+} // namespace bahasa
+
+#endif // BAHASA_COMPILER_HPP
@@ -0,0 +1,365 @@
+#include "Server.hpp"
+#include "ast/Symbol.hpp"
+#include "backend/JIT.hpp"
+#include "parser/Source.hpp"
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/ThreadPool.h>
+#include <csignal>
+#include <cstdint>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace bahasa {
+
+// Wire format: every message is a sequence of length-prefixed strings.
+// Request:  command, sourcePath, outputPath, optLevel, bitcode, useCache, hasSource, source
+// Response: exitCode, diagnostics, outputName, artifact
+
+// Longest string either side accepts, so a bad length cannot make the
+// receiver allocate without bound. Requests carry at most a source file,
+// responses an executable.
+static constexpr uint64_t maxRequestField = 256ull << 20;
+static constexpr uint64_t maxResponseField = 1ull << 30;
+
+static bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+static bool readAll(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t got = ::read(fd, data, size);
+        if (got <= 0) {
+            return false;
+        }
+        data += got;
+        size -= got;
+    }
+    return true;
+}
+
+static bool sendString(int fd, llvm::StringRef value) {
+    uint64_t size = value.size();
+    return writeAll(fd, reinterpret_cast<const char*>(&size), sizeof(size)) &&
+           writeAll(fd, value.data(), value.size());
+}
+
+static bool receiveString(int fd, std::string& value, uint64_t maxSize) {
+    uint64_t size;
+    if (!readAll(fd, reinterpret_cast<char*>(&size), sizeof(size)) || size > maxSize) {
+        return false;
+    }
+    value.resize(size);
+    return readAll(fd, value.data(), size);
+}
+
+static bool receiveStrings(int fd, std::vector<std::string>& values, size_t count, uint64_t maxSize) {
+    values.resize(count);
+    for (auto& value : values) {
+        if (!receiveString(fd, value, maxSize)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whether the process at the other end of a connected socket runs as our
+// user. Both sides check: the client runs what the server sends back, the
+// server compiles what the client sends.
+static bool peerIsSameUser(int fd) {
+#if defined(SO_PEERCRED)
+    ucred credentials{};
+    socklen_t length = sizeof(credentials);
+    if (::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0) {
+        return false;
+    }
+    return credentials.uid == ::getuid();
+#else
+    uid_t uid;
+    gid_t gid;
+    return ::getpeereid(fd, &uid, &gid) == 0 && uid == ::getuid();
+#endif
+}
+
+static sockaddr_un socketAddress(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Jalur soket terlalu panjang: " + socketPath);
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+    return address;
+}
+
+static std::string fallbackSocketDirectory() {
+    return "/tmp/bahasa-" + std::to_string(::getuid());
+}
+
+std::string defaultSocketPath() {
+    if (const char* path = std::getenv("BAHASA_SOKET")) {
+        return path;
+    }
+    if (const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR")) {
+        llvm::SmallString<128> path(runtimeDir);
+        llvm::sys::path::append(path, "bahasa.sock");
+        return std::string(path);
+    }
+    return fallbackSocketDirectory() + "/bahasa.sock";
+}
+
+// The fallback directory sits in the shared /tmp: create it private, and
+// refuse one that someone else made first or that others can enter
+static void preparePrivateDirectory(const std::string& directory) {
+    if (::mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST) {
+        throw std::runtime_error("Gagal membuat direktori soket: " + directory);
+    }
+    struct stat status;
+    if (::lstat(directory.c_str(), &status) != 0 || !S_ISDIR(status.st_mode) ||
+        status.st_uid != ::getuid() || (status.st_mode & 077) != 0) {
+        throw std::runtime_error("Direktori soket bukan milik pengguna ini atau tidak privat: " + directory);
+    }
+}
+
+// The optimization level as the client sends it, the enumerator's number;
+// anything else is rejected rather than compiled at some other level
+static bool parseOptLevel(llvm::StringRef text, OptLevel& level) {
+    unsigned value;
+    if (text.getAsInteger(10, value) || value > static_cast<unsigned>(OptLevel::Os)) {
+        return false;
+    }
+    level = static_cast<OptLevel>(value);
+    return true;
+}
+
+// Compile one request into a private temporary directory and send back the result
+static void handleConnection(int fd) {
+    std::vector<std::string> fields;
+    if (!peerIsSameUser(fd) || !receiveStrings(fd, fields, 8, maxRequestField)) {
+        return;
+    }
+    // Every name this request interns is dropped once no other request is running
+    SymbolScope symbols;
+    const std::string& command = fields[0];
+    const std::string& sourcePath = fields[1];
+    const std::string& outputPath = fields[2];
+
+    CompileOptions options;
+    bool validOptLevel = parseOptLevel(fields[3], options.optLevel);
+    options.bitcode = fields[4] == "1";
+    options.useCache = fields[5] == "1";
+    if (fields[6] == "1") {
+        options.sourceText = std::move(fields[7]);
+    }
+
+    std::ostringstream diagnostics;
+    std::string outputName = outputPath;
+    std::string artifact;
+    int exitCode = 1;
+
+    llvm::SmallString<128> workDir;
+    if (!validOptLevel) {
+        diagnostics << "Galat: Tingkat optimasi tidak dikenal: " << fields[3] << "\n";
+    } else if (llvm::sys::fs::createUniqueDirectory("bahasa-layani", workDir)) {
+        diagnostics << "Galat: Gagal membuat direktori sementara\n";
+    } else {
+        llvm::SmallString<128> artifactPath(workDir);
+        llvm::sys::path::append(artifactPath, "keluaran");
+        std::string target(artifactPath);
+
+        if (command == "ir") {
+            std::string moduleName;
+            exitCode = compileLLVMIR(sourcePath, target, options, diagnostics, &moduleName);
+            if (outputName.empty()) {
+                outputName = moduleName + (options.bitcode ? ".bc" : ".ll");
+            }
+        } else if (command == "susun") {
+            exitCode = compileToExecutable(sourcePath, target, options, diagnostics);
+        } else if (command == "objek") {
+            exitCode = compileToObject(sourcePath, target, options, diagnostics);
+        } else {
+            diagnostics << "Perintah tidak dikenal: " << command << "\n";
+        }
+
+        if (exitCode == 0) {
+            auto buffer = llvm::MemoryBuffer::getFile(target, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+            if (buffer) {
+                artifact = (*buffer)->getBuffer().str();
+            } else {
+                diagnostics << "Galat: Gagal membaca hasil kompilasi\n";
+                exitCode = 1;
+            }
+        }
+        llvm::sys::fs::remove_directories(workDir);
+    }
+
+    sendString(fd, std::to_string(exitCode)) &&
+        sendString(fd, diagnostics.str()) &&
+        sendString(fd, outputName) &&
+        sendString(fd, artifact);
+}
+
+static std::string activeSocketPath;
+
+static void stopServer(int) {
+    ::unlink(activeSocketPath.c_str());
+    std::_Exit(0);
+}
+
+int serve(const std::string& socketPath, unsigned workers) {
+    try {
+        // Initialize once up front; every request after this reuses the registered targets
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+
+        int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) {
+            throw std::runtime_error("Gagal membuat soket");
+        }
+
+        sockaddr_un address = socketAddress(socketPath);
+        llvm::StringRef directory = llvm::sys::path::parent_path(socketPath);
+        if (directory == fallbackSocketDirectory()) {
+            preparePrivateDirectory(directory.str());
+        }
+        ::unlink(socketPath.c_str());
+        if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(listener, SOMAXCONN) != 0) {
+            ::close(listener);
+            throw std::runtime_error("Gagal mendengarkan pada soket: " + socketPath);
+        }
+
+        activeSocketPath = socketPath;
+        std::signal(SIGINT, stopServer);
+        std::signal(SIGTERM, stopServer);
+        std::signal(SIGPIPE, SIG_IGN);
+
+        llvm::ThreadPool pool(llvm::hardware_concurrency(workers));
+        std::cerr << "Melayani pada " << socketPath << " dengan " << pool.getThreadCount() << " pekerja\n";
+
+        while (true) {
+            int connection = ::accept(listener, nullptr, nullptr);
+            if (connection < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            pool.async([connection] {
+                handleConnection(connection);
+                ::close(connection);
+            });
+        }
+
+        pool.wait();
+        ::close(listener);
+        ::unlink(socketPath.c_str());
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Galat: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+bool forwardToServer(const std::string& socketPath, const std::string& command,
+                     const std::string& sourcePath, const std::string& outputPath,
+                     const CompileOptions& options, int& exitCode, std::ostream& diagnostics) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    sockaddr_un address;
+    try {
+        address = socketAddress(socketPath);
+    } catch (const std::exception&) {
+        ::close(fd);
+        return false;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return false;
+    }
+    // Anyone could have bound the path first; never use a server of another user
+    if (!peerIsSameUser(fd)) {
+        ::close(fd);
+        diagnostics << "Peringatan: soket " << socketPath
+                    << " dimiliki pengguna lain, dikompilasi secara lokal\n";
+        return false;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    // Send the source bytes along so the server never depends on our working directory
+    std::optional<SourceBuffer> source;
+    try {
+        source = options.sourceText ? SourceBuffer::fromString(*options.sourceText, sourcePath)
+                                    : SourceBuffer::fromFile(sourcePath);
+    } catch (const std::exception& e) {
+        ::close(fd);
+        diagnostics << "Galat: " << e.what() << std::endl;
+        exitCode = 1;
+        return true;
+    }
+
+    std::string serverCommand = command == "jalankan" ? "objek" : command;
+    std::vector<std::string> response;
+    bool sent = sendString(fd, serverCommand) &&
+                sendString(fd, sourcePath) &&
+                sendString(fd, command == "ir" ? outputPath : "") &&
+                sendString(fd, std::to_string(static_cast<int>(options.optLevel))) &&
+                sendString(fd, options.bitcode ? "1" : "0") &&
+                sendString(fd, options.useCache ? "1" : "0") &&
+                sendString(fd, "1") &&
+                sendString(fd, source->text());
+    bool received = sent && receiveStrings(fd, response, 4, maxResponseField);
+    ::close(fd);
+    if (!received) {
+        return false;
+    }
+
+    exitCode = std::atoi(response[0].c_str());
+    diagnostics << response[1];
+    if (exitCode != 0) {
+        return true;
+    }
+
+    const std::string& artifact = response[3];
+    try {
+        if (command == "jalankan") {
+            JIT jit;
+            jit.addObject(llvm::MemoryBuffer::getMemBufferCopy(artifact));
+            exitCode = jit.runMain();
+        } else if (command == "susun") {
+            writeExecutable(artifact, outputPath);
+        } else {
+            std::error_code ec;
+            llvm::raw_fd_ostream out(response[2], ec, llvm::sys::fs::OF_None);
+            if (ec) {
+                throw std::runtime_error("Tidak dapat membuka berkas keluaran: " + response[2]);
+            }
+            out << artifact;
+        }
+    } catch (const std::exception& e) {
+        diagnostics << "Galat: " << e.what() << std::endl;
+        exitCode = 1;
+    }
+    return true;
+}
+
+} // namespace bahasa
@@ -0,0 +1,28 @@
+#ifndef BAHASA_SERVER_HPP
+#define BAHASA_SERVER_HPP
+
+#include "Compiler.hpp"
+#include <string>
+
+namespace bahasa {
+
+// $BAHASA_SOKET, else $XDG_RUNTIME_DIR/bahasa.sock, else
+// /tmp/bahasa-<uid>/bahasa.sock in a directory only this user can enter
+std::string defaultSocketPath();
+
+// `bahasa layani`: keep LLVM initialized and answer compile requests on a
+// Unix domain socket, each connection handled by a worker from the pool.
+int serve(const std::string& socketPath, unsigned workers);
+
+// Client side of `layani` for ir, susun and jalankan. The server returns the
+// artifact bytes (IR, executable or object) plus diagnostics; outputs are
+// written and programs are run by the calling process. Returns false when no
+// server is listening, so the caller can compile locally.
+bool forwardToServer(const std::string& socketPath, const std::string& command,
+                     const std::string& sourcePath, const std::string& outputPath,
+                     const CompileOptions& options, int& exitCode,
+                     std::ostream& diagnostics = std::cerr);
+
+} // namespace bahasa
+
+#endif // BAHASA_SERVER_HPP
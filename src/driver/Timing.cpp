@@ -0,0 +1,116 @@
+#include "Timing.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <sys/resource.h>
+
+namespace bahasa {
+
+// CPU time of the whole process, so phases that fan out to worker threads
+// (lexing, parsing and codegen of large files) are counted in full. When
+// several files compile at once, a phase also includes the other jobs' time.
+static double cpuSeconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+static long peakRSSKilobytes() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // Reported in bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+TimingReport::Scope::Scope(TimingReport* report, std::string name)
+    : report(report), name(std::move(name)) {
+    if (report) {
+        wallStart = std::chrono::steady_clock::now();
+        cpuStart = cpuSeconds();
+    }
+}
+
+TimingReport::Scope::~Scope() {
+    if (!report) {
+        return;
+    }
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wallStart;
+    report->phases.push_back({name, wall.count(), cpuSeconds() - cpuStart, peakRSSKilobytes()});
+}
+
+void TimingReport::printTable(std::ostream& os) const {
+    const int nameWidth = 14;
+    const int numberWidth = 15;
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    std::string line = "+" + std::string(nameWidth, '-') + "+" + std::string(numberWidth, '-') +
+                       "+" + std::string(numberWidth, '-') + "+" + std::string(numberWidth, '-') + "+";
+
+    os << line << "\n"
+       << "| " << std::setw(nameWidth - 1) << std::left << "Fase"
+       << "| " << std::setw(numberWidth - 1) << std::left << "Dinding (ms)"
+       << "| " << std::setw(numberWidth - 1) << std::left << "CPU (ms)"
+       << "| " << std::setw(numberWidth - 1) << std::left << "RSS (KB)" << "|\n"
+       << line << "\n";
+
+    double totalWall = 0;
+    double totalCpu = 0;
+    long peak = 0;
+    os << std::fixed << std::setprecision(3);
+    for (const auto& phase : phases) {
+        os << "| " << std::setw(nameWidth - 1) << std::left << phase.name
+           << "| " << std::setw(numberWidth - 1) << std::right << phase.wallSeconds * 1000
+           << "| " << std::setw(numberWidth - 1) << std::right << phase.cpuSeconds * 1000
+           << "| " << std::setw(numberWidth - 1) << std::right << phase.peakRSSKilobytes << "|\n";
+        totalWall += phase.wallSeconds;
+        totalCpu += phase.cpuSeconds;
+        peak = std::max(peak, phase.peakRSSKilobytes);
+    }
+    os << line << "\n"
+       << "| " << std::setw(nameWidth - 1) << std::left << "total"
+       << "| " << std::setw(numberWidth - 1) << std::right << totalWall * 1000
+       << "| " << std::setw(numberWidth - 1) << std::right << totalCpu * 1000
+       << "| " << std::setw(numberWidth - 1) << std::right << peak << "|\n"
+       << line << "\n";
+    os.flags(flags);
+    os.precision(precision);
+
+    if (!passTimings.empty()) {
+        os << passTimings;
+    }
+}
+
+static void writeJSONString(std::ostream& os, const std::string& value) {
+    os << '"';
+    for (char c : value) {
+        switch (c) {
+            case '"': os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\t': os << "\\t"; break;
+            case '\r': os << "\\r"; break;
+            default: os << c; break;
+        }
+    }
+    os << '"';
+}
+
+void TimingReport::printJSON(std::ostream& os) const {
+    os << "{\"fase\": [";
+    for (size_t i = 0; i < phases.size(); i++) {
+        const auto& phase = phases[i];
+        os << (i ? ", " : "") << "{\"nama\": ";
+        writeJSONString(os, phase.name);
+        os << ", \"dinding_detik\": " << phase.wallSeconds
+           << ", \"cpu_detik\": " << phase.cpuSeconds
+           << ", \"rss_puncak_kb\": " << phase.peakRSSKilobytes << "}";
+    }
+    os << "], \"llvm_pass\": ";
+    writeJSONString(os, passTimings);
+    os << "}\n";
+}
+
+} // namespace bahasa
@@ -0,0 +1,48 @@
+#ifndef BAHASA_TIMING_HPP
+#define BAHASA_TIMING_HPP
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bahasa {
+
+// Per-phase wall/CPU time and peak RSS for `--waktu`
+class TimingReport {
+public:
+    struct Phase {
+        std::string name;
+        double wallSeconds;
+        double cpuSeconds;
+        long peakRSSKilobytes;  // Process high-water mark when the phase ended
+    };
+
+    // Records one phase from construction until destruction
+    class Scope {
+    public:
+        Scope(TimingReport* report, std::string name);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        TimingReport* report;
+        std::string name;
+        std::chrono::steady_clock::time_point wallStart;
+        double cpuStart;
+    };
+
+    // LLVM's TimePassesHandler output for the optimization pipeline
+    std::string passTimings;
+
+    void printTable(std::ostream& os) const;
+    void printJSON(std::ostream& os) const;
+
+private:
+    std::vector<Phase> phases;
+};
+
+} // namespace bahasa
+
+#endif // BAHASA_TIMING_HPP
@@ -1,23 +1,14 @@
 #include "parser/Lexer.hpp"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <iomanip>
 #include "parser/Parser.hpp"
+#include "parser/Source.hpp"
 #include "ast/AST.hpp"
 #include "ast/ASTPrinter.hpp"
 #include "codegen/Codegen.hpp"
-#include <unistd.h> // For mkstemp
-
-std::string readFile(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        throw std::runtime_error("Tidak dapat membuka berkas: " + path);
-    }
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
-}
+#include "driver/Compiler.hpp"
+#include "driver/Server.hpp"
+#include <llvm/Support/Path.h>
 
 std::string getTokenTypeName(bahasa::TokenType type) {
     switch (type) {
@@ -53,149 +44,55 @@ void printHorizontalLine(int width) {
 }
 
 void printUsage(const char* program) {
-    std::cerr << "Penggunaan: " << program << " <perintah> [opsi] <berkas_sumber>\n\n"
+    std::cerr << "Penggunaan: " << program << " <perintah> [opsi] <berkas_sumber>...\n\n"
               << "Perintah:\n"
               << "  ir       Kompilasi kode sumber ke LLVM IR\n"
               << "  susun    Kompilasi kode sumber ke program\n"
               << "  jalankan Kompilasi dan jalankan program\n"
               << "  ast      Tampilkan AST\n"
-              << "  token    Tampilkan daftar token\n\n"
+              << "  token    Tampilkan daftar token\n"
+              << "  layani   Jalankan server kompilasi pada soket Unix\n\n"
               << "Opsi:\n"
-              << "  -o <berkas>   Berkas keluaran (default: a.out untuk susun/jalankan, <nama_modul>.ll untuk ir)\n";
-}
-
-int compileLLVMIR(const std::string& sourcePath, const std::string& outputPath = "") {
-    try {
-        std::string source = readFile(sourcePath);
-        bahasa::Lexer lexer(source);
-        auto tokens = lexer.tokenize();
-        
-        bahasa::Parser parser(tokens);
-        auto ast = parser.parse();
-        
-        std::string moduleName = parser.getModuleName();
-        bahasa::Codegen codegen(moduleName);
-        codegen.generate(ast);
-
-        // Determine output file name
-        std::string outFile = outputPath.empty() ? moduleName + ".ll" : outputPath;
-        
-        // Open output file
-        std::ofstream out(outFile);
-        if (!out.is_open()) {
-            throw std::runtime_error("Tidak dapat membuka berkas keluaran: " + outFile);
-        }
-
-        // Redirect LLVM IR to file
-        std::string ir;
-        llvm::raw_string_ostream irStream(ir);
-        codegen.dump(irStream);
-        out << ir;
-        
-        //std::cout << "Berhasil dikompilasi ke " << outFile << std::endl;
-        return 0;
-
-    } catch (const std::exception& e) {
-        std::cerr << "Galat: " << e.what() << std::endl;
-        return 1;
-    }
-}
-
-// Helper function to create temporary file
-std::string createTempFile(const std::string& suffix) {
-    char tempPath[] = "bahasa_XXXXXX";
-    int fd = mkstemp(tempPath);
-    if (fd == -1) {
-        throw std::runtime_error("Gagal membuat berkas sementara");
-    }
-    close(fd);
-    
-    // If there's a suffix, rename the file
-    std::string finalPath = tempPath + suffix;
-    if (suffix.length() > 0) {
-        if (rename(tempPath, finalPath.c_str()) != 0) {
-            std::remove(tempPath);
-            throw std::runtime_error("Gagal mengubah nama berkas sementara");
-        }
-    }
-    
-    return finalPath;
+              << "  -o <berkas>   Berkas keluaran (default: a.out untuk susun/jalankan, <nama_modul>.ll untuk ir)\n"
+              << "  -O0..-O3, -Os Tingkat optimasi untuk ir/susun/jalankan (default: -O0)\n"
+              << "  --bitcode     Keluarkan LLVM bitcode (.bc) untuk ir\n"
+              << "  --tanpa-cache Jangan gunakan cache kompilasi untuk susun/jalankan\n"
+              << "  --inkremental Susun ulang hanya fungsi yang berubah sejak susun sebelumnya (membutuhkan cache)\n"
+              << "  --waktu[=json] Tampilkan waktu dan memori setiap fase kompilasi\n"
+              << "  --tanpa-layanan Kompilasi langsung walaupun server layani sedang berjalan\n"
+              << "  --soket <jalur> Soket server layani (default: $XDG_RUNTIME_DIR/bahasa.sock)\n"
+              << "  -j <n>        Jumlah pekerja untuk layani, ir/susun dengan banyak berkas, dan kompilasi berkas besar (default: jumlah inti)\n";
 }
 
-int compileToExecutable(const std::string& sourcePath, const std::string& outputPath = "a.out") {
-    try {
-        // First compile to temporary IR file
-        std::string tempIR = createTempFile(".ll");
-        
-        // Compile to LLVM IR first
-        if (int result = compileLLVMIR(sourcePath, tempIR)) {
-            return result;
-        }
-        
-        // Then compile IR to executable with proper linking and suppress warnings
-        std::string cmd = "clang -w " + tempIR + " -o " + outputPath;
-        #ifdef __APPLE__
-            cmd += " -L/usr/lib -lSystem";  // Add system library for macOS
-        #else
-            cmd += " -lc";  // Add C library for Linux
-        #endif
-        cmd += " 2>/dev/null";
-        
-        if (int result = system(cmd.c_str())) {
-            std::remove(tempIR.c_str());
-            throw std::runtime_error("Gagal mengkompilasi berkas IR ke program");
-        }
-        
-        // Clean up temporary file
-        std::remove(tempIR.c_str());
-        
-        //std::cout << "Successfully compiled to " << outputPath << std::endl;
-        return 0;
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Error: " << e.what() << std::endl;
-        return 1;
-    }
+// Returns true if arg is one of -O0, -O1, -O2, -O3 or -Os
+bool parseOptLevel(const std::string& arg, bahasa::OptLevel& level) {
+    if (arg == "-O0") level = bahasa::OptLevel::O0;
+    else if (arg == "-O1") level = bahasa::OptLevel::O1;
+    else if (arg == "-O2") level = bahasa::OptLevel::O2;
+    else if (arg == "-O3") level = bahasa::OptLevel::O3;
+    else if (arg == "-Os") level = bahasa::OptLevel::Os;
+    else return false;
+    return true;
 }
 
-int runExecutable(const std::string& sourcePath) {
-    try {
-        // First compile to temporary executable
-        std::string tempExe = createTempFile("");
-        
-        // Compile to executable first
-        if (int result = compileToExecutable(sourcePath, tempExe)) {
-            return result;
-        }
-        
-        // Run the executable with proper path
-        std::string cmd = "./" + tempExe;
-        int result = system(cmd.c_str());
-        
-        // Clean up temporary executable
-        std::remove(tempExe.c_str());
-        
-        return result;
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Error: " << e.what() << std::endl;
-        return 1;
-    }
+// Returns true if text is a whole number of workers, at least 1
+bool parseWorkerCount(llvm::StringRef text, unsigned& count) {
+    return !text.getAsInteger(10, count) && count >= 1;
 }
 
 // Add this function to print the AST
 int printAST(const std::string& sourcePath) {
     try {
-        std::string source = readFile(sourcePath);
-        bahasa::Lexer lexer(source);
+        bahasa::SourceBuffer source = bahasa::SourceBuffer::fromFile(sourcePath);
+        bahasa::Lexer lexer(source.text());
         auto tokens = lexer.tokenize();
         
         bahasa::Parser parser(tokens);
-        auto ast = parser.parse();
+        bahasa::Program program = parser.parse();
         
         // Print the AST
         std::cout << "Abstract Syntax Tree:\n";
-        for (const auto& stmt : ast) {
+        for (const auto& stmt : program.statements) {
             bahasa::ASTPrinter::printStmt(stmt);
         }
         
@@ -207,7 +104,7 @@ int printAST(const std::string& sourcePath) {
 }
 
 // Add this helper function to escape special characters
-std::string escapeString(const std::string& str) {
+std::string escapeString(std::string_view str) {
     std::string result;
     for (char c : str) {
         switch (c) {
@@ -225,8 +122,8 @@ std::string escapeString(const std::string& str) {
 // Update the printTokens function
 int printTokens(const std::string& sourcePath) {
     try {
-        std::string source = readFile(sourcePath);
-        bahasa::Lexer lexer(source);
+        bahasa::SourceBuffer source = bahasa::SourceBuffer::fromFile(sourcePath);
+        bahasa::Lexer lexer(source.text());
         auto tokens = lexer.tokenize();
         
         // Calculate column widths
@@ -282,86 +179,160 @@ int printTokens(const std::string& sourcePath) {
 }
 
 int main(int argc, char* argv[]) {
-    if (argc < 3) {
+    if (argc < 2 || (argc < 3 && std::string(argv[1]) != "layani")) {
         printUsage(argv[0]);
         return 1;
     }
 
     std::string command = argv[1];
     
-    if (command == "ir") {
+    if (command == "ir" || command == "susun" || command == "jalankan") {
         std::string outputPath;
-        std::string sourcePath;
+        std::vector<std::string> sourcePaths;
+        unsigned jobs = 0;
+        std::string socketPath = bahasa::defaultSocketPath();
+        bool useServer = true;
+        std::string timingFormat;
+        bahasa::CompileOptions options;
         
         // Parse options
         for (int i = 2; i < argc; i++) {
             std::string arg = argv[i];
             if (arg == "-o") {
+                if (command == "jalankan") {
+                    // Ignore -o for jalankan since nothing is written
+                    std::cerr << "Peringatan: opsi -o diabaikan untuk perintah jalankan\n";
+                    i++; // Skip the next argument
+                    continue;
+                }
                 if (i + 1 >= argc) {
                     std::cerr << "Galat: -o membutuhkan nama berkas keluaran\n";
                     return 1;
                 }
                 outputPath = argv[++i];
+            } else if (parseOptLevel(arg, options.optLevel)) {
+                continue;
+            } else if (arg == "--bitcode" && command == "ir") {
+                options.bitcode = true;
+            } else if (arg == "--tanpa-cache" && command != "ir") {
+                options.useCache = false;
+            } else if (arg == "--inkremental" && command == "susun") {
+                options.incremental = true;
+            } else if (arg == "--waktu" || arg == "--waktu=tabel" || arg == "--waktu=json") {
+                timingFormat = arg == "--waktu=json" ? "json" : "tabel";
+            } else if (arg == "--tanpa-layanan") {
+                useServer = false;
+            } else if (arg == "-j") {
+                if (i + 1 >= argc) {
+                    std::cerr << "Galat: -j membutuhkan jumlah pekerja\n";
+                    return 1;
+                }
+                if (!parseWorkerCount(argv[++i], jobs)) {
+                    std::cerr << "Galat: -j membutuhkan jumlah pekerja minimal 1, bukan: " << argv[i] << "\n";
+                    return 1;
+                }
+            } else if (arg == "--soket") {
+                if (i + 1 >= argc) {
+                    std::cerr << "Galat: --soket membutuhkan jalur soket\n";
+                    return 1;
+                }
+                socketPath = argv[++i];
             } else {
-                sourcePath = arg;
+                sourcePaths.push_back(arg);
             }
         }
         
-        if (sourcePath.empty()) {
+        if (sourcePaths.empty()) {
             std::cerr << "Galat: Berkas sumber tidak ditemukan\n";
             printUsage(argv[0]);
             return 1;
         }
+        if (sourcePaths.size() > 1 && command == "jalankan") {
+            std::cerr << "Galat: jalankan hanya menerima satu berkas sumber\n";
+            return 1;
+        }
+        if (sourcePaths.size() > 1 && !outputPath.empty()) {
+            std::cerr << "Galat: -o hanya dapat dipakai dengan satu berkas sumber\n";
+            return 1;
+        }
+        // Incremental builds keep their per-function objects in the cache
+        if (options.incremental && !options.useCache) {
+            std::cerr << "Galat: --inkremental tidak dapat dipakai bersama --tanpa-cache\n";
+            return 1;
+        }
         
-        return compileLLVMIR(sourcePath, outputPath);
-    }
-    else if (command == "susun") {
-        std::string outputPath = "a.out";
-        std::string sourcePath;
-        
-        // Parse options
-        for (int i = 2; i < argc; i++) {
-            std::string arg = argv[i];
-            if (arg == "-o") {
-                if (i + 1 >= argc) {
-                    std::cerr << "Galat: -o membutuhkan nama berkas keluaran\n";
-                    return 1;
-                }
-                outputPath = argv[++i];
+        auto compileOne = [&](const std::string& sourcePath, const std::string& output,
+                              std::ostream& diagnostics) {
+            // Hand the work to a running `bahasa layani` when there is one; timings and
+            // incremental builds need a local compile
+            int exitCode;
+            if (useServer && timingFormat.empty() && !options.incremental &&
+                bahasa::forwardToServer(socketPath, command, sourcePath, output, options, exitCode, diagnostics)) {
+                return exitCode;
+            }
+            
+            bahasa::TimingReport report;
+            bahasa::CompileOptions jobOptions = options;
+            if (!timingFormat.empty()) {
+                jobOptions.timings = &report;
+            }
+            
+            if (command == "ir") {
+                exitCode = bahasa::compileLLVMIR(sourcePath, output, jobOptions, diagnostics);
+            } else if (command == "susun") {
+                exitCode = bahasa::compileToExecutable(sourcePath, output, jobOptions, diagnostics);
             } else {
-                sourcePath = arg;
+                exitCode = bahasa::runExecutable(sourcePath, jobOptions, diagnostics);
             }
-        }
+            
+            if (timingFormat == "json") {
+                report.printJSON(diagnostics);
+            } else if (!timingFormat.empty()) {
+                report.printTable(diagnostics);
+            }
+            return exitCode;
+        };
         
-        if (sourcePath.empty()) {
-            std::cerr << "Galat: Berkas sumber tidak ditemukan\n";
-            printUsage(argv[0]);
-            return 1;
+        if (sourcePaths.size() == 1) {
+            if (outputPath.empty() && command == "susun") {
+                outputPath = "a.out";
+            }
+            options.threads = jobs;
+            return compileOne(sourcePaths[0], outputPath, std::cerr);
         }
         
-        return compileToExecutable(sourcePath, outputPath);
+        // Several sources: one output per file named after its stem, built in parallel.
+        // The files already occupy the workers, so each one is lexed on its own thread
+        options.threads = 1;
+        return bahasa::compileBatch(sourcePaths, jobs, [&](const std::string& sourcePath, std::ostream& diagnostics) {
+            std::string output = llvm::sys::path::stem(sourcePath).str();
+            if (command == "ir") {
+                output += options.bitcode ? ".bc" : ".ll";
+            }
+            return compileOne(sourcePath, output, diagnostics);
+        });
     }
-    else if (command == "jalankan") {
-        std::string sourcePath;
+    else if (command == "layani") {
+        std::string socketPath = bahasa::defaultSocketPath();
+        unsigned workers = 0;
         
-        // Parse options (ignore -o for jalankan since we use temp file)
+        // Parse options
         for (int i = 2; i < argc; i++) {
             std::string arg = argv[i];
-            if (arg == "-o") {
-                std::cerr << "Peringatan: opsi -o diabaikan untuk perintah jalankan\n";
-                i++; // Skip the next argument
+            if (arg == "--soket" && i + 1 < argc) {
+                socketPath = argv[++i];
+            } else if (arg == "-j" && i + 1 < argc) {
+                if (!parseWorkerCount(argv[++i], workers)) {
+                    std::cerr << "Galat: -j membutuhkan jumlah pekerja minimal 1, bukan: " << argv[i] << "\n";
+                    return 1;
+                }
             } else {
-                sourcePath = arg;
+                std::cerr << "Galat: opsi tidak dikenal untuk layani: " << arg << "\n";
+                return 1;
             }
         }
         
-        if (sourcePath.empty()) {
-            std::cerr << "Galat: Berkas sumber tidak ditemukan\n";
-            printUsage(argv[0]);
-            return 1;
-        }
-        
-        return runExecutable(sourcePath);
+        return bahasa::serve(socketPath, workers);
     }
     else if (command == "ast") {
         std::string sourcePath;
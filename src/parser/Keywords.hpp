@@ -0,0 +1,62 @@
+#ifndef BAHASA_KEYWORDS_HPP
+#define BAHASA_KEYWORDS_HPP
+
+#include "Lexer.hpp"
+#include <string_view>
+
+namespace bahasa {
+
+// Keyword recognition, switched on length and then first character so any
+// word costs at most one string compare. There is no table to build at
+// startup and nothing is allocated. Non-keywords are IDENTIFIER.
+constexpr TokenType classifyWord(std::string_view word) {
+    switch (word.size()) {
+        case 3:
+            if (word[0] == 'i' && word == "int") return TokenType::INT;
+            if (word[0] == 'd' && word == "dan") return TokenType::DAN;
+            break;
+        case 4:
+            if (word[0] == 'j' && word == "jika") return TokenType::IF;
+            if (word[0] == 'a' && word == "atau") return TokenType::ATAU;
+            break;
+        case 5:
+            if (word[0] == 'm' && word == "modul") return TokenType::MODUL;
+            if (word[0] == 'd' && word == "dalam") return TokenType::DALAM;
+            break;
+        case 6:
+            switch (word[0]) {
+                case 'f': if (word == "fungsi") return TokenType::FUNCTION; break;
+                case 'a': if (word == "adalah") return TokenType::ADALAH; break;
+                case 'm':
+                    if (word == "mutasi") return TokenType::MUTASI;
+                    if (word == "modulo") return TokenType::MODULO;
+                    break;
+                case 's': if (word == "selama") return TokenType::SELAMA; break;
+                case 'l': if (word == "lanjut") return TokenType::LANJUT; break;
+                default: break;
+            }
+            break;
+        case 7:
+            if (word[0] == 'k' && word == "koleksi") return TokenType::KOLEKSI;
+            if (word[0] == 'a' && word == "abaikan") return TokenType::ABAIKAN;
+            break;
+        case 8:
+            if (word[0] == 'b' && word == "berhenti") return TokenType::BERHENTI;
+            break;
+        default:
+            break;
+    }
+    return TokenType::IDENTIFIER;
+}
+
+static_assert(classifyWord("fungsi") == TokenType::FUNCTION, "");
+static_assert(classifyWord("modulo") == TokenType::MODULO, "");
+static_assert(classifyWord("modul") == TokenType::MODUL, "");
+static_assert(classifyWord("abaikan") == TokenType::ABAIKAN, "");
+static_assert(classifyWord("berhenti") == TokenType::BERHENTI, "");
+static_assert(classifyWord("mutasix") == TokenType::IDENTIFIER, "");
+static_assert(classifyWord("") == TokenType::IDENTIFIER, "");
+
+} // namespace bahasa
+
+#endif // BAHASA_KEYWORDS_HPP
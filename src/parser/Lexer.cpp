@@ -1,24 +1,14 @@
 #include "Lexer.hpp"
-#include <unordered_map>
+#include "Keywords.hpp"
+#include "Scan.hpp"
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/Threading.h>
+#include <algorithm>
 #include <stdexcept>
 
 namespace bahasa {
 
-static std::unordered_map<std::string, TokenType> keywords = {
-    {"fungsi", TokenType::FUNCTION},
-    {"int", TokenType::INT},
-    {"mutasi", TokenType::MUTASI},
-    {"jika", TokenType::IF},
-    {"modul", TokenType::MODUL},
-    {"modulo", TokenType::MODULO},
-    {"adalah", TokenType::ADALAH},
-    {"dan", TokenType::DAN},
-    {"atau", TokenType::ATAU},
-    {"koleksi", TokenType::KOLEKSI},
-    {"abaikan", TokenType::ABAIKAN},
-};
-
-Lexer::Lexer(std::string source) : source(std::move(source)) {}
+Lexer::Lexer(std::string_view source) : source(source) {}
 
 bool Lexer::isAtEnd() const {
     return current >= source.length();
@@ -52,22 +42,17 @@ void Lexer::skipWhitespace() {
             case ' ':
             case '\r':
             case '\t':
-                advance();
+                current = scan::skipBlanks(source, current);
                 break;
             case '\n':
                 line++;
                 advance();
-                start = current; // Reset start position after newline
+                lineStart = current;
                 break;
             case '-':
                 if (peekNext() == '-') {  // Comment starts with --
-                    // Advance past both dashes
-                    advance();
-                    advance();
-                    // Skip until end of line
-                    while (peek() != '\n' && !isAtEnd()) {
-                        advance();
-                    }
+                    // Skip past both dashes to the end of line
+                    current = scan::findNewline(source, current + 2);
                 } else {
                     return;
                 }
@@ -79,34 +64,42 @@ void Lexer::skipWhitespace() {
 }
 
 Token Lexer::identifier() {
-    while (isAlphaNumeric(peek())) advance();
-    
-    std::string text = source.substr(start, current - start);
-    // Trim whitespace from the lexeme
-    text.erase(0, text.find_first_not_of(" \t\n\r"));
-    text.erase(text.find_last_not_of(" \t\n\r") + 1);
-    TokenType type = TokenType::IDENTIFIER;
+    current = scan::skipWord(source, current);
     
-    auto it = keywords.find(text);
-    if (it != keywords.end()) {
-        type = it->second;
+    Token token = makeToken(classifyWord(source.substr(start, current - start)));
+    if (token.type == TokenType::IDENTIFIER) {
+        token.symbol = Symbol::intern(token.lexeme);
     }
-    
-    return Token(type, text, line);
+    return token;
 }
 
 Token Lexer::number() {
-    while (isDigit(peek())) advance();
-    
-    std::string num = source.substr(start, current - start);
-    // Trim whitespace from the lexeme
-    num.erase(0, num.find_first_not_of(" \t\n\r"));
-    num.erase(num.find_last_not_of(" \t\n\r") + 1);
-    return Token(TokenType::NUMBER, num, line);
+    current = scan::skipDigits(source, current);
+    return makeToken(TokenType::NUMBER);
 }
 
 Token Lexer::string() {
-    std::string value;
+    // Common case: no escapes, the literal is a view of the source
+    int startLine = line;
+    int startColumn = static_cast<int>(start - lineStart) + 1;
+    size_t contentStart = current;
+    while ((current = scan::findStringStop(source, current)) < source.length() && peek() == '\n') {
+        line++;
+        lineStart = ++current;
+    }
+    
+    if (isAtEnd()) {
+        throw std::runtime_error("String belum ditutup.");
+    }
+    
+    if (peek() == '"') {
+        std::string_view value = source.substr(contentStart, current - contentStart);
+        advance(); // Consume the closing "
+        return Token(TokenType::STRING, value, startLine, startColumn, start);
+    }
+    
+    // Escapes present: materialize an owned copy that the token can point into
+    std::string value(source.substr(contentStart, current - contentStart));
     while (peek() != '"' && !isAtEnd()) {
         if (peek() == '\\') {
             advance(); // consume backslash
@@ -130,9 +123,15 @@ Token Lexer::string() {
                     throw std::runtime_error("Urutan escape tidak valid");
             }
             advance();
+        } else if (peek() == '\n') {
+            value += '\n';
+            line++;
+            lineStart = ++current;
         } else {
-            value += peek();
-            advance();
+            // Copy the run up to the next quote, backslash or newline at once
+            size_t runEnd = scan::findStringStop(source, current);
+            value.append(source.substr(current, runEnd - current));
+            current = runEnd;
         }
     }
     
@@ -141,15 +140,13 @@ Token Lexer::string() {
     }
     
     advance(); // Consume the closing "
-    return Token(TokenType::STRING, value, line);
+    unescaped.push_back(std::move(value));
+    return Token(TokenType::STRING, unescaped.back(), startLine, startColumn, start);
 }
 
 Token Lexer::makeToken(TokenType type) {
-    std::string text = source.substr(start, current - start);
-    // Trim whitespace from the lexeme
-    text.erase(0, text.find_first_not_of(" \t\n\r"));
-    text.erase(text.find_last_not_of(" \t\n\r") + 1);
-    return Token(type, text, line);
+    return Token(type, source.substr(start, current - start), line,
+                 static_cast<int>(start - lineStart) + 1, start);
 }
 
 bool Lexer::isDigit(char c) const {
@@ -162,19 +159,15 @@ bool Lexer::isAlpha(char c) const {
            c == '_';
 }
 
-bool Lexer::isAlphaNumeric(char c) const {
-    return isAlpha(c) || isDigit(c);
-}
-
 std::vector<Token> Lexer::tokenize() {
     std::vector<Token> tokens;
     
     while (!isAtEnd()) {
-        start = current;
         skipWhitespace();
         
         if (isAtEnd()) break;
         
+        start = current;
         char c = advance();
         
         if (isDigit(c)) {
@@ -231,8 +224,90 @@ std::vector<Token> Lexer::tokenize() {
         }
     }
     
-    tokens.push_back(Token(TokenType::END, "", line));
+    tokens.push_back(Token(TokenType::END, "", line, static_cast<int>(current - lineStart) + 1, current));
+    return tokens;
+}
+
+// Where a piece starting at or after `from` may begin: just past a newline,
+// preferring one followed by `fungsi` within the next 64KB
+static size_t findSplitPoint(std::string_view source, size_t from) {
+    constexpr size_t lookahead = 64 * 1024;
+    size_t function = source.substr(0, std::min(source.size(), from + lookahead)).find("\nfungsi", from);
+    if (function != std::string_view::npos) {
+        return function + 1;
+    }
+    return scan::findNewline(source, from) + 1;
+}
+
+std::vector<Token> Lexer::tokenizeParallel(unsigned threads, size_t minChunkBytes) {
+    unsigned workers = llvm::hardware_concurrency(threads).compute_thread_count();
+    size_t count = std::min<size_t>(workers, source.size() / std::max<size_t>(minChunkBytes, 1));
+    if (count < 2) {
+        return tokenize();
+    }
+    
+    std::vector<size_t> bounds = {0};
+    for (size_t i = 1; i < count; i++) {
+        size_t split = findSplitPoint(source, std::max(bounds.back(), i * source.size() / count));
+        if (split > bounds.back() && split < source.length()) {
+            bounds.push_back(split);
+        }
+    }
+    bounds.push_back(source.length());
+    count = bounds.size() - 1;
+    
+    // Every piece is lexed as if it started at top level. That holds for the
+    // first one, and a piece that lexes cleanly to its end (no string left
+    // open; a comment always ends at the newline) proves it for the next.
+    // So if all pieces succeed the result is exact; otherwise start over
+    // sequentially, which also reports the error properly.
+    std::vector<std::unique_ptr<Lexer>> lexers;
+    std::vector<std::vector<Token>> results(count);
+    std::vector<char> failed(count, 0);
+    for (size_t i = 0; i < count; i++) {
+        lexers.push_back(std::make_unique<Lexer>(source.substr(bounds[i], bounds[i + 1] - bounds[i])));
+    }
+    {
+        llvm::ThreadPool pool(llvm::hardware_concurrency(workers));
+        for (size_t i = 0; i < count; i++) {
+            pool.async([&, i] {
+                try {
+                    results[i] = lexers[i]->tokenize();
+                } catch (const std::exception&) {
+                    failed[i] = 1;
+                }
+            });
+        }
+        pool.wait();
+    }
+    if (std::find(failed.begin(), failed.end(), 1) != failed.end()) {
+        return tokenize();
+    }
+    
+    // Concatenate, shifting lines and offsets; only the last END survives
+    size_t total = 1;
+    for (const auto& part : results) {
+        total += part.size() - 1;
+    }
+    std::vector<Token> tokens;
+    tokens.reserve(total);
+    int lineBase = 0;
+    for (size_t i = 0; i < count; i++) {
+        auto& part = results[i];
+        int newlines = part.back().line - 1;
+        size_t keep = i + 1 < count ? part.size() - 1 : part.size();
+        for (size_t j = 0; j < keep; j++) {
+            Token& token = part[j];
+            token.line += lineBase;
+            token.offset += bounds[i];
+            tokens.push_back(token);
+        }
+        lineBase += newlines;
+    }
+    line = lineBase + 1;
+    current = source.length();
+    pieces = std::move(lexers);
     return tokens;
 }
 
-} // namespace bahasa 
\ No newline at end of file
+} // namespace bahasa
@@ -1,7 +1,11 @@
 #ifndef BAHASA_LEXER_HPP
 #define BAHASA_LEXER_HPP
 
+#include "ast/Symbol.hpp"
+#include <deque>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace bahasa {
@@ -18,6 +22,10 @@ enum class TokenType {
     TIDUR,        // tidur (sleep function)
     KOLEKSI,      // koleksi (array type)
     ABAIKAN,      // abaikan (try block)
+    SELAMA,       // selama (while loop)
+    DALAM,        // dalam (selama x dalam koleksi)
+    BERHENTI,     // berhenti (break)
+    LANJUT,       // lanjut (continue)
     
     // Symbols
     ARROW,        // ->
@@ -55,22 +63,35 @@ enum class TokenType {
 
 struct Token {
     TokenType type;
-    std::string lexeme;
+    std::string_view lexeme;  // View into the source, or into the Lexer for escaped strings
     int line;
+    int column;
+    size_t offset;
+    Symbol symbol;            // Interned name, for IDENTIFIER tokens only
     
-    Token(TokenType t, std::string l, int ln) 
-        : type(t), lexeme(std::move(l)), line(ln) {}
+    Token(TokenType t, std::string_view l, int ln, int col = 0, size_t off = 0)
+        : type(t), lexeme(l), line(ln), column(col), offset(off) {}
 };
 
 class Lexer {
 public:
-    explicit Lexer(std::string source);
+    // The source is not copied: it, and this Lexer (which owns string
+    // literals that needed unescaping), must outlive the returned tokens.
+    explicit Lexer(std::string_view source);
     std::vector<Token> tokenize();
+    // The same tokens as tokenize(), lexing pieces of the source concurrently
+    // on up to `threads` workers (0 = one per core) once it is at least two
+    // pieces of minChunkBytes. Pieces are split just after a newline,
+    // preferably before a line starting with `fungsi`.
+    std::vector<Token> tokenizeParallel(unsigned threads = 0, size_t minChunkBytes = 512 * 1024);
 
 private:
-    std::string source;
-    int current = 0;
-    int start = 0;
+    std::string_view source;
+    std::deque<std::string> unescaped;
+    std::vector<std::unique_ptr<Lexer>> pieces;  // Own the string literals of tokenizeParallel chunks
+    size_t current = 0;
+    size_t start = 0;
+    size_t lineStart = 0;
     int line = 1;
     
     bool isAtEnd() const;
@@ -84,7 +105,6 @@ private:
     Token makeToken(TokenType type);
     bool isDigit(char c) const;
     bool isAlpha(char c) const;
-    bool isAlphaNumeric(char c) const;
     Token string();
 };
 
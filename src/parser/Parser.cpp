@@ -1,12 +1,57 @@
 #include "Parser.hpp"
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/Threading.h>
+#include <algorithm>
+#include <array>
 #include <stdexcept>
 
 namespace bahasa {
 
-Parser::Parser(std::vector<Token> tokens) : tokens(std::move(tokens)) {}
+namespace {
+
+// Infix operators by token, lowest to highest binding:
+// atau < dan < comparisons < + - < * / modulo. Precedence 0 means the
+// token is not an infix operator.
+struct InfixOperator {
+    int precedence;
+    BinaryOp op;
+    bool comparison;
+};
+
+constexpr size_t tokenTypeCount = static_cast<size_t>(TokenType::INVALID) + 1;
+
+constexpr std::array<InfixOperator, tokenTypeCount> makeInfixOperators() {
+    std::array<InfixOperator, tokenTypeCount> table{};
+    auto set = [&table](TokenType type, int precedence, BinaryOp op, bool comparison) {
+        table[static_cast<size_t>(type)] = {precedence, op, comparison};
+    };
+    set(TokenType::ATAU, 1, BinaryOp::Or, false);
+    set(TokenType::DAN, 2, BinaryOp::And, false);
+    set(TokenType::LESS, 3, BinaryOp::Less, true);
+    set(TokenType::LESS_EQUAL, 3, BinaryOp::LessEqual, true);
+    set(TokenType::GREATER, 3, BinaryOp::Greater, true);
+    set(TokenType::GREATER_EQUAL, 3, BinaryOp::GreaterEqual, true);
+    set(TokenType::ADALAH, 3, BinaryOp::Equal, true);
+    set(TokenType::PLUS, 4, BinaryOp::Add, false);
+    set(TokenType::MINUS, 4, BinaryOp::Sub, false);
+    set(TokenType::MULTIPLY, 5, BinaryOp::Mul, false);
+    set(TokenType::DIVIDE, 5, BinaryOp::Div, false);
+    set(TokenType::MODULO, 5, BinaryOp::Mod, false);
+    return table;
+}
+
+constexpr std::array<InfixOperator, tokenTypeCount> infixOperators = makeInfixOperators();
+
+} // namespace
+
+Parser::Parser(std::vector<Token> tokens)
+    : ownedTokens(std::move(tokens)), tokens(ownedTokens), limit(ownedTokens.size()) {}
+
+Parser::Parser(llvm::ArrayRef<Token> tokens, size_t begin, size_t end)
+    : tokens(tokens), limit(end), current(static_cast<int>(begin)) {}
 
 bool Parser::isAtEnd() const {
-    return current >= tokens.size() || tokens[current].type == TokenType::END;
+    return static_cast<size_t>(current) >= limit || tokens[current].type == TokenType::END;
 }
 
 Token Parser::peek() const {
@@ -44,13 +89,97 @@ bool Parser::consume(TokenType type, const std::string& message) {
     return false;
 }
 
-std::vector<StmtPtr> Parser::parse() {
+Program Parser::parse() {
+    llvm::SmallVector<StmtPtr, 64> statements;
+    parseDeclarations(statements);
+    program.statements = program.copy<StmtPtr>(statements);
+    return std::move(program);
+}
+
+Program Parser::parseParallel(unsigned threads, size_t minFunctions) {
+    // Top-level functions: `fungsi` outside any braces
+    std::vector<size_t> functionStarts;
+    int depth = 0;
+    for (size_t i = current; i < limit; i++) {
+        switch (tokens[i].type) {
+            case TokenType::LBRACE: depth++; break;
+            case TokenType::RBRACE: depth = std::max(depth - 1, 0); break;
+            case TokenType::FUNCTION:
+                if (depth == 0) {
+                    functionStarts.push_back(i);
+                }
+                break;
+            default: break;
+        }
+    }
+    
+    unsigned workers = llvm::hardware_concurrency(threads).compute_thread_count();
+    size_t count = std::min<size_t>(workers, functionStarts.size() / std::max<size_t>(minFunctions, 1));
+    if (count < 2) {
+        return parse();
+    }
+    std::vector<size_t> bounds;
+    for (size_t i = 0; i < count; i++) {
+        bounds.push_back(functionStarts[i * functionStarts.size() / count]);
+    }
+    bounds.push_back(limit);
+    
+    // A declaration that parses cleanly never consumes a top-level `fungsi`
+    // other than its own, so a run that parses cleanly up to the next run's
+    // first function gives exactly what the sequential parser would
+    std::vector<std::unique_ptr<Parser>> parsers;
+    std::vector<llvm::SmallVector<StmtPtr, 0>> results(count);
+    std::vector<char> failed(count, 0);
+    llvm::SmallVector<StmtPtr, 64> statements;
+    bool prefixFailed = false;
+    for (size_t i = 0; i < count; i++) {
+        parsers.push_back(std::unique_ptr<Parser>(new Parser(tokens, bounds[i], bounds[i + 1])));
+    }
+    {
+        llvm::ThreadPool pool(llvm::hardware_concurrency(workers));
+        for (size_t i = 0; i < count; i++) {
+            pool.async([&, i] {
+                try {
+                    parsers[i]->parseDeclarations(results[i]);
+                } catch (const std::exception&) {
+                    failed[i] = 1;
+                }
+            });
+        }
+        
+        // Meanwhile the module header and anything else before the first function
+        limit = bounds[0];
+        try {
+            parseDeclarations(statements);
+        } catch (const std::exception&) {
+            prefixFailed = true;
+        }
+        pool.wait();
+    }
+    limit = tokens.size();
+    
+    // Reparse from the start so the error reported is the sequential parser's
+    if (prefixFailed || std::find(failed.begin(), failed.end(), 1) != failed.end()) {
+        current = 0;
+        program = Program();
+        return parse();
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        statements.append(results[i].begin(), results[i].end());
+        program.adopt(std::move(parsers[i]->program));
+    }
+    current = static_cast<int>(limit);
+    program.statements = program.copy<StmtPtr>(statements);
+    return std::move(program);
+}
+
+void Parser::parseDeclarations(llvm::SmallVectorImpl<StmtPtr>& statements) {
     // Parse module declaration first
-    if (match(TokenType::MODUL)) {
+    if (current == 0 && match(TokenType::MODUL)) {
         parseModuleDecl();
     }
 
-    std::vector<StmtPtr> statements;
     while (!isAtEnd()) {
         if (match(TokenType::FUNCTION)) {
             statements.push_back(parseFunction());
@@ -60,18 +189,17 @@ std::vector<StmtPtr> Parser::parse() {
             advance(); // Skip unknown tokens for now
         }
     }
-    return statements;
 }
 
 void Parser::parseModuleDecl() {
     consume(TokenType::IDENTIFIER, "Harap masukkan nama modul.");
-    moduleName = previous().lexeme;
+    program.moduleName = std::string(previous().lexeme);
 }
 
 StmtPtr Parser::parseFunction() {
     // Parse function name
     consume(TokenType::IDENTIFIER, "Harap masukkan nama fungsi.");
-    std::string name = previous().lexeme;
+    Symbol name = previous().symbol;
     
     // Parse parameters
     consume(TokenType::LPAREN, "Harap '(' setelah nama fungsi.");
@@ -81,119 +209,131 @@ StmtPtr Parser::parseFunction() {
     // Parse return type
     consume(TokenType::ARROW, "Harap '->' setelah parameter.");
     consume(TokenType::INT, "Harap tipe kembali.");
-    std::string returnType = previous().lexeme;
+    std::string_view returnType = program.copy(previous().lexeme);
     
     // Parse body
     consume(TokenType::LBRACE, "Harap '{' sebelum tubuh fungsi.");
+    auto body = parseBlock("Harap '}' setelah tubuh fungsi.");
     
-    std::vector<StmtPtr> body;
+    return program.create<FunctionStmt>(name, params, returnType, body);
+}
+
+StmtPtr Parser::parseStatement() {
+    if (match(TokenType::RETURN_ARROW)) {
+        return program.create<ReturnStmt>(parseExpression());
+    }
+    if (match(TokenType::MUTASI)) return parseVarDecl();
+    if (match(TokenType::IF)) return parseIf();
+    if (match(TokenType::ABAIKAN)) return parseTryBlock();
+    if (match(TokenType::SELAMA)) return parseWhile();
+    if (match(TokenType::BERHENTI)) return program.create<BreakStmt>();
+    if (match(TokenType::LANJUT)) return program.create<ContinueStmt>();
+
+    // Expression statement (e.g., function calls)
+    return program.create<ExprStmt>(parseExpression());
+}
+
+llvm::ArrayRef<StmtPtr> Parser::parseBlock(const std::string& message) {
+    llvm::SmallVector<StmtPtr, 16> statements;
     while (!check(TokenType::RBRACE) && !isAtEnd()) {
-        if (match(TokenType::RETURN_ARROW)) {
-            auto expr = parseExpression();
-            body.push_back(std::make_shared<ReturnStmt>(expr));
-        } else if (match(TokenType::MUTASI)) {
-            body.push_back(parseVarDecl());
-        } else if (match(TokenType::IF)) {
-            body.push_back(parseIf());
-        } else if (match(TokenType::ABAIKAN)) {
-            body.push_back(parseTryBlock());
-        } else {
-            // Parse expression statement (e.g., function calls)
-            auto expr = parseExpression();
-            body.push_back(std::make_shared<ExprStmt>(expr));
-        }
+        statements.push_back(parseStatement());
     }
-    
-    consume(TokenType::RBRACE, "Harap '}' setelah tubuh fungsi.");
-    
-    return std::make_shared<FunctionStmt>(name, params, returnType, body);
+    consume(TokenType::RBRACE, message);
+    return program.copy<StmtPtr>(statements);
 }
 
 StmtPtr Parser::parseIf() {
     ExprPtr condition = parseExpression();
     
     consume(TokenType::LBRACE, "Harap '{' setelah kondisi if.");
+    auto thenBranch = parseBlock("Harap '}' setelah tubuh if.");
     
-    std::vector<StmtPtr> thenBranch;
-    while (!check(TokenType::RBRACE) && !isAtEnd()) {
-        if (match(TokenType::RETURN_ARROW)) {
-            auto expr = parseExpression();
-            thenBranch.push_back(std::make_shared<ReturnStmt>(expr));
-        } else if (match(TokenType::MUTASI)) {
-            thenBranch.push_back(parseVarDecl());
-        } else {
-            // Handle function calls and other expressions
-            auto expr = parseExpression();
-            thenBranch.push_back(std::make_shared<ExprStmt>(expr));
-        }
+    return program.create<IfStmt>(condition, thenBranch);
+}
+
+StmtPtr Parser::parseWhile() {
+    // selama x dalam koleksi { ... }; not at END, so the lookahead exists
+    if (check(TokenType::IDENTIFIER) && tokens[current + 1].type == TokenType::DALAM) {
+        Symbol element = advance().symbol;
+        advance();
+        consume(TokenType::IDENTIFIER, "Harap nama koleksi setelah 'dalam'.");
+        Symbol array = previous().symbol;
+
+        consume(TokenType::LBRACE, "Harap '{' setelah nama koleksi.");
+        auto body = parseBlock("Harap '}' setelah tubuh selama.");
+        return program.create<ForEachStmt>(element, array, body);
     }
-    
-    consume(TokenType::RBRACE, "Harap '}' setelah tubuh if.");
-    
-    return std::make_shared<IfStmt>(condition, thenBranch);
+
+    ExprPtr condition = parseExpression();
+
+    consume(TokenType::LBRACE, "Harap '{' setelah kondisi selama.");
+    auto body = parseBlock("Harap '}' setelah tubuh selama.");
+
+    return program.create<WhileStmt>(condition, body);
 }
 
-std::vector<Parameter> Parser::parseParameters() {
-    std::vector<Parameter> params;
+llvm::ArrayRef<Parameter> Parser::parseParameters() {
+    llvm::SmallVector<Parameter, 4> params;
     
     if (!check(TokenType::RPAREN)) {
         do {
             consume(TokenType::IDENTIFIER, "Harap masukkan nama parameter.");
-            std::string paramName = previous().lexeme;
+            Symbol paramName = previous().symbol;
             
             consume(TokenType::COLON, "Harap ':' setelah nama parameter.");
             consume(TokenType::INT, "Harap tipe parameter.");
-            std::string paramType = previous().lexeme;
+            std::string_view paramType = program.copy(previous().lexeme);
             
             params.emplace_back(paramName, paramType);
         } while (match(TokenType::COMMA));
     }
     
-    return params;
+    return program.copy<Parameter>(params);
 }
 
 ExprPtr Parser::parseExpression() {
     // Try to parse an assignment first
     if (match(TokenType::IDENTIFIER)) {
-        std::string name = previous().lexeme;
+        int start = current - 1;
+        Symbol name = previous().symbol;
         
         if (match(TokenType::EQUALS)) {
             ExprPtr value = parseExpression();
-            return std::make_shared<AssignmentExpr>(name, value);
+            return program.create<AssignmentExpr>(name, value);
+        }
+        if (match(TokenType::DOT)) {
+            ExprPtr index = parseIndex();
+            if (match(TokenType::EQUALS)) {
+                ExprPtr value = parseExpression();
+                return program.create<ArrayAssignmentExpr>(name, index, value);
+            }
         }
         
-        // If it's not an assignment, rewind and parse as comparison
-        current--;  // Rewind the identifier token
-        return parseComparison();
-    }
-    
-    return parseComparison();
-}
-
-ExprPtr Parser::parseComparison() {
-    ExprPtr expr = parseBinary();
-    
-    while (match(TokenType::LESS) || match(TokenType::GREATER) ||
-           match(TokenType::LESS_EQUAL) || match(TokenType::GREATER_EQUAL) ||
-           match(TokenType::ADALAH)) {
-        std::string op = previous().lexeme;
-        ExprPtr right = parseBinary();
-        expr = std::make_shared<ComparisonExpr>(expr, op, right);
+        // If it's not an assignment, rewind and parse as an operator expression
+        current = start;  // Rewind the identifier token
+        return parseBinary(1);
     }
     
-    return expr;
+    return parseBinary(1);
 }
 
-ExprPtr Parser::parseBinary() {
+ExprPtr Parser::parseBinary(int minPrecedence) {
     ExprPtr expr = parsePrimary();
     
-    while (match(TokenType::PLUS) || match(TokenType::MINUS) ||
-           match(TokenType::MULTIPLY) || match(TokenType::DIVIDE) ||
-           match(TokenType::MODULO) || match(TokenType::DAN) ||
-           match(TokenType::ATAU)) {
-        std::string op = previous().lexeme;
-        ExprPtr right = parsePrimary();
-        expr = std::make_shared<BinaryExpr>(expr, op, right);
+    while (true) {
+        const InfixOperator& info = infixOperators[static_cast<size_t>(peek().type)];
+        if (info.precedence == 0 || info.precedence < minPrecedence) {
+            break;
+        }
+        advance();
+        // All operators are left-associative: the right operand only takes
+        // operators that bind tighter
+        ExprPtr right = parseBinary(info.precedence + 1);
+        if (info.comparison) {
+            expr = program.create<ComparisonExpr>(expr, info.op, right);
+        } else {
+            expr = program.create<BinaryExpr>(expr, info.op, right);
+        }
     }
     
     return expr;
@@ -201,52 +341,60 @@ ExprPtr Parser::parseBinary() {
 
 StmtPtr Parser::parseVarDecl() {
     consume(TokenType::IDENTIFIER, "Harap masukkan nama variabel setelah 'mutasi'.");
-    std::string name = previous().lexeme;
+    Symbol name = previous().symbol;
     
     // Handle type declaration
     consume(TokenType::COLON, "Harap ':' setelah nama variabel.");
-    std::shared_ptr<Type> type = parseType();
+    Type* type = parseType();
     
     consume(TokenType::EQUALS, "Harap '=' setelah deklarasi tipe.");
     ExprPtr initializer = parseExpression();
     
-    return std::make_shared<VarDeclStmt>(name, type, initializer);
+    return program.create<VarDeclStmt>(name, type, initializer);
 }
 
-std::shared_ptr<Type> Parser::parseType() {
+Type* Parser::parseType() {
     if (match(TokenType::KOLEKSI)) {
         consume(TokenType::LBRACKET, "Harap '[' setelah 'koleksi'.");
         consume(TokenType::INT, "Harap tipe elemen array.");
         consume(TokenType::RBRACKET, "Harap ']' setelah tipe elemen.");
-        return Type::createArray(Type::createInt(), 0); // Size will be set later
+        // Size will be set later
+        return program.create<Type>(Type::Kind::Array, program.create<Type>(Type::Kind::Int), 0);
     }
     consume(TokenType::INT, "Harap tipe variabel.");
-    return Type::createInt();
+    return program.create<Type>(Type::Kind::Int);
 }
 
 ExprPtr Parser::parsePrimary() {
     if (match(TokenType::NUMBER)) {
-        return std::make_shared<NumberExpr>(std::stoi(previous().lexeme));
+        return program.create<NumberExpr>(std::stoi(std::string(previous().lexeme)));
     }
     
     if (match(TokenType::STRING)) {
-        return std::make_shared<StringExpr>(previous().lexeme);
+        return program.create<StringExpr>(program.copy(previous().lexeme));
     }
     
     if (match(TokenType::IDENTIFIER)) {
-        std::string name = previous().lexeme;
+        Symbol name = previous().symbol;
         if (match(TokenType::LPAREN)) {
             return parseCall(name);
         }
         if (match(TokenType::DOT)) {
             return parseArrayIndex(name);
         }
-        return std::make_shared<VariableExpr>(name);
+        return program.create<VariableExpr>(name);
     }
     
     if (match(TokenType::LBRACKET)) {
         return parseArrayLiteral();
     }
+
+    if (match(TokenType::KOLEKSI)) {
+        consume(TokenType::LPAREN, "Harap '(' setelah 'koleksi'.");
+        ExprPtr size = parseExpression();
+        consume(TokenType::RPAREN, "Harap ')' setelah ukuran koleksi.");
+        return program.create<ArrayAllocExpr>(size);
+    }
     
     if (match(TokenType::LPAREN)) {
         ExprPtr expr = parseExpression();
@@ -260,14 +408,14 @@ ExprPtr Parser::parsePrimary() {
     return nullptr;
 }
 
-ExprPtr Parser::parseCall(std::string callee) {
+ExprPtr Parser::parseCall(Symbol callee) {
     auto arguments = parseArguments();
     consume(TokenType::RPAREN, "Harap ')' setelah argumen.");
-    return std::make_shared<CallExpr>(callee, arguments);
+    return program.create<CallExpr>(callee, arguments);
 }
 
-std::vector<ExprPtr> Parser::parseArguments() {
-    std::vector<ExprPtr> arguments;
+llvm::ArrayRef<ExprPtr> Parser::parseArguments() {
+    llvm::SmallVector<ExprPtr, 4> arguments;
     
     if (!check(TokenType::RPAREN)) {
         do {
@@ -275,20 +423,31 @@ std::vector<ExprPtr> Parser::parseArguments() {
         } while (match(TokenType::COMMA));
     }
     
-    return arguments;
+    return program.copy<ExprPtr>(arguments);
+}
+
+ExprPtr Parser::parseArrayIndex(Symbol name) {
+    return program.create<ArrayIndexExpr>(name, parseIndex());
 }
 
-ExprPtr Parser::parseArrayIndex(const std::string& name) {
+ExprPtr Parser::parseIndex() {
     if (match(TokenType::NUMBER)) {
-        ExprPtr index = std::make_shared<NumberExpr>(std::stoi(previous().lexeme));
-        return std::make_shared<ArrayIndexExpr>(name, index);
+        return program.create<NumberExpr>(std::stoi(std::string(previous().lexeme)));
+    }
+    if (match(TokenType::IDENTIFIER)) {
+        return program.create<VariableExpr>(previous().symbol);
     }
-    error("Harap masukkan indeks array berupa angka");
+    if (match(TokenType::LPAREN)) {
+        ExprPtr index = parseExpression();
+        consume(TokenType::RPAREN, "Harap ')' setelah indeks array.");
+        return index;
+    }
+    error("Harap masukkan indeks array berupa angka, variabel atau (ekspresi)");
     return nullptr;
 }
 
 ExprPtr Parser::parseArrayLiteral() {
-    std::vector<ExprPtr> elements;
+    llvm::SmallVector<ExprPtr, 16> elements;
     
     if (!check(TokenType::RBRACKET)) {
         do {
@@ -297,35 +456,20 @@ ExprPtr Parser::parseArrayLiteral() {
     }
     
     consume(TokenType::RBRACKET, "Harap ']' setelah elemen array.");
-    return std::make_shared<ArrayLiteralExpr>(elements);
+    return program.create<ArrayLiteralExpr>(program.copy<ExprPtr>(elements));
 }
 
 StmtPtr Parser::parseTryBlock() {
     consume(TokenType::LBRACE, "Harap '{' setelah 'abaikan'");
-    std::vector<StmtPtr> statements;
-    
-    while (!check(TokenType::RBRACE) && !isAtEnd()) {
-        if (match(TokenType::RETURN_ARROW)) {
-            auto expr = parseExpression();
-            statements.push_back(std::make_shared<ReturnStmt>(expr));
-        } else if (match(TokenType::MUTASI)) {
-            statements.push_back(parseVarDecl());
-        } else if (match(TokenType::IF)) {
-            statements.push_back(parseIf());
-        } else {
-            auto expr = parseExpression();
-            statements.push_back(std::make_shared<ExprStmt>(expr));
-        }
-    }
-    
-    consume(TokenType::RBRACE, "Harap '}' setelah blok abaikan");
-    return std::make_shared<TryStmt>(statements);
+    auto statements = parseBlock("Harap '}' setelah blok abaikan");
+    return program.create<TryStmt>(statements);
 }
 
 void Parser::error(const std::string& message) {
     std::string location = "";
     if (!tokens.empty() && current < tokens.size()) {
-        location = " pada baris " + std::to_string(tokens[current].line);
+        location = " pada baris " + std::to_string(tokens[current].line) +
+                   ", kolom " + std::to_string(tokens[current].column);
     }
     throw std::runtime_error("Galat" + location + ": " + message);
 }
@@ -3,6 +3,7 @@
 
 #include "Lexer.hpp"
 #include "ast/AST.hpp"
+#include <llvm/ADT/SmallVector.h>
 #include <vector>
 #include <memory>
 
@@ -11,13 +12,24 @@ namespace bahasa {
 class Parser {
 public:
     explicit Parser(std::vector<Token> tokens);
-    std::vector<StmtPtr> parse();
-    std::string getModuleName() const { return moduleName; }
+    // The parser can only be used once: the Program takes over its arena
+    Program parse();
+    // The same Program as parse(), parsing runs of top-level functions
+    // concurrently on up to `threads` workers (0 = one per core) once there
+    // are at least two runs of minFunctions. On a syntax error the tokens are
+    // parsed again sequentially, so the error reported is the first one.
+    Program parseParallel(unsigned threads = 0, size_t minFunctions = 256);
 
 private:
-    std::vector<Token> tokens;
+    std::vector<Token> ownedTokens;
+    llvm::ArrayRef<Token> tokens;
+    size_t limit;  // Parse stops here as if at END
     int current = 0;
-    std::string moduleName;
+    Program program;
+
+    // A parser for tokens[begin, end) of a parent's tokens
+    Parser(llvm::ArrayRef<Token> tokens, size_t begin, size_t end);
+    void parseDeclarations(llvm::SmallVectorImpl<StmtPtr>& statements);
 
     bool isAtEnd() const;
     Token peek() const;
@@ -29,27 +41,29 @@ private:
     void error(const std::string& message);
     
     StmtPtr parseFunction();
-    std::vector<Parameter> parseParameters();
+    llvm::ArrayRef<Parameter> parseParameters();
     ExprPtr parseExpression();
-    ExprPtr parseBinary();
+    // Operators binding at least as tightly as minPrecedence (Pratt parsing)
+    ExprPtr parseBinary(int minPrecedence);
     ExprPtr parsePrimary();
     StmtPtr parseVarDecl();
-    ExprPtr parseCall(std::string callee);
-    std::vector<ExprPtr> parseArguments();
+    ExprPtr parseCall(Symbol callee);
+    llvm::ArrayRef<ExprPtr> parseArguments();
     StmtPtr parseIf();
-    ExprPtr parseComparison();
+    // selama, in both its condition and its dalam form
+    StmtPtr parseWhile();
     void parseModuleDecl();
-    std::shared_ptr<Type> parseType();
-    ExprPtr parseArrayIndex(const std::string& name);
+    Type* parseType();
+    ExprPtr parseArrayIndex(Symbol name);
+    // What follows the '.' of array.index: a number, a variable or (expression)
+    ExprPtr parseIndex();
     ExprPtr parseArrayLiteral();
 
-    // Statement parsing
+    // Statement parsing, shared by every block
     StmtPtr parseStatement();
+    // Statements up to the closing '}', which it consumes
+    llvm::ArrayRef<StmtPtr> parseBlock(const std::string& message);
     StmtPtr parseTryBlock();
-    StmtPtr parseFunctionDeclaration();
-    StmtPtr parseVarDeclaration();
-    StmtPtr parseReturnStatement();
-    StmtPtr parseExpressionStatement();
 };
 
 } // namespace bahasa
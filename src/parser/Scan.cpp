@@ -0,0 +1,158 @@
+#include "Scan.hpp"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define BAHASA_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace bahasa {
+namespace scan {
+
+namespace {
+
+// Index of the first byte at or after pos whose membership in cls differs
+// from `member`
+size_t scalarScan(const char* data, size_t pos, size_t size, CharClass cls, bool member) {
+    while (pos < size && inClass(data[pos], cls) == member) pos++;
+    return pos;
+}
+
+#ifdef BAHASA_SCAN_X86
+
+// Signed byte compares are enough: every range we test lies in 0x00-0x7f,
+// and bytes >= 0x80 compare as negative, so they fall outside all of them.
+
+inline __m128i range128(__m128i v, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)), _mm_cmpgt_epi8(_mm_set1_epi8(hi + 1), v));
+}
+
+inline __m128i eq128(__m128i v, char c) {
+    return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+}
+
+inline uint32_t classMask128(__m128i v, CharClass cls) {
+    __m128i m;
+    switch (cls) {
+        case BLANK:
+            m = _mm_or_si128(_mm_or_si128(eq128(v, ' '), eq128(v, '\t')), eq128(v, '\r'));
+            break;
+        case WORD:
+            m = _mm_or_si128(_mm_or_si128(range128(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z'),
+                                          range128(v, '0', '9')),
+                             eq128(v, '_'));
+            break;
+        case DIGIT:
+            m = range128(v, '0', '9');
+            break;
+        case NEWLINE:
+            m = eq128(v, '\n');
+            break;
+        default:
+            m = _mm_or_si128(_mm_or_si128(eq128(v, '"'), eq128(v, '\\')), eq128(v, '\n'));
+            break;
+    }
+    return static_cast<uint32_t>(_mm_movemask_epi8(m));
+}
+
+size_t sse2Scan(const char* data, size_t pos, size_t size, CharClass cls, bool member) {
+    const uint32_t flip = member ? 0xFFFFu : 0;
+    while (pos + 16 <= size) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        uint32_t stop = classMask128(v, cls) ^ flip;
+        if (stop) return pos + __builtin_ctz(stop);
+        pos += 16;
+    }
+    return scalarScan(data, pos, size, cls, member);
+}
+
+__attribute__((target("avx2"))) inline __m256i range256(__m256i v, char lo, char hi) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(lo - 1)),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), v));
+}
+
+__attribute__((target("avx2"))) inline __m256i eq256(__m256i v, char c) {
+    return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c));
+}
+
+__attribute__((target("avx2"))) inline uint32_t classMask256(__m256i v, CharClass cls) {
+    __m256i m;
+    switch (cls) {
+        case BLANK:
+            m = _mm256_or_si256(_mm256_or_si256(eq256(v, ' '), eq256(v, '\t')), eq256(v, '\r'));
+            break;
+        case WORD:
+            m = _mm256_or_si256(_mm256_or_si256(range256(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z'),
+                                                range256(v, '0', '9')),
+                                eq256(v, '_'));
+            break;
+        case DIGIT:
+            m = range256(v, '0', '9');
+            break;
+        case NEWLINE:
+            m = eq256(v, '\n');
+            break;
+        default:
+            m = _mm256_or_si256(_mm256_or_si256(eq256(v, '"'), eq256(v, '\\')), eq256(v, '\n'));
+            break;
+    }
+    return static_cast<uint32_t>(_mm256_movemask_epi8(m));
+}
+
+__attribute__((target("avx2"))) size_t avx2Scan(const char* data, size_t pos, size_t size, CharClass cls,
+                                                bool member) {
+    const uint32_t flip = member ? 0xFFFFFFFFu : 0;
+    while (pos + 32 <= size) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        uint32_t stop = classMask256(v, cls) ^ flip;
+        if (stop) return pos + __builtin_ctz(stop);
+        pos += 32;
+    }
+    // Finish a 16-31 byte tail with SSE2 before going scalar
+    return sse2Scan(data, pos, size, cls, member);
+}
+
+#endif // BAHASA_SCAN_X86
+
+using ScanFunction = size_t (*)(const char*, size_t, size_t, CharClass, bool);
+
+struct Kernel {
+    ScanFunction scan;
+    const char* name;
+};
+
+Kernel selectKernel() {
+    const char* forced = std::getenv("BAHASA_SIMD");
+    bool scalarOnly = forced && std::strcmp(forced, "skalar") == 0;
+    bool noAvx2 = forced && (scalarOnly || std::strcmp(forced, "sse2") == 0);
+#ifdef BAHASA_SCAN_X86
+    if (!noAvx2 && __builtin_cpu_supports("avx2")) {
+        return {avx2Scan, "avx2"};
+    }
+    if (!scalarOnly) {
+        return {sse2Scan, "sse2"};
+    }
+#else
+    (void)noAvx2;
+#endif
+    return {scalarScan, "skalar"};
+}
+
+const Kernel& kernel() {
+    static const Kernel selected = selectKernel();
+    return selected;
+}
+
+} // namespace
+
+size_t scanWide(std::string_view text, size_t pos, CharClass cls, bool member) {
+    return kernel().scan(text.data(), pos, text.size(), cls, member);
+}
+
+const char* implementation() {
+    return kernel().name;
+}
+
+} // namespace scan
+} // namespace bahasa
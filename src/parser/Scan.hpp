@@ -0,0 +1,74 @@
+#ifndef BAHASA_SCAN_HPP
+#define BAHASA_SCAN_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace bahasa {
+namespace scan {
+
+// Bulk character-class scanning for the Lexer. Every function starts at
+// `pos` and returns the index of the first byte that ends the run, or
+// text.size(). Most runs in real code are a handful of bytes, so the first
+// 16 are checked inline against a class table; longer runs (indentation,
+// comments, long literals) continue 32 bytes at a time with AVX2 or 16 with
+// SSE2, picked once at runtime, or a scalar loop elsewhere.
+
+enum CharClass : uint8_t {
+    BLANK = 1 << 0,        // ' ', '\t', '\r'
+    WORD = 1 << 1,         // [A-Za-z0-9_]
+    DIGIT = 1 << 2,        // [0-9]
+    NEWLINE = 1 << 3,      // '\n'
+    STRING_STOP = 1 << 4,  // '"', '\\', '\n'
+};
+
+constexpr std::array<uint8_t, 256> makeClassTable() {
+    std::array<uint8_t, 256> table{};
+    table[' '] = table['\t'] = table['\r'] = BLANK;
+    for (int c = 'a'; c <= 'z'; c++) table[c] |= WORD;
+    for (int c = 'A'; c <= 'Z'; c++) table[c] |= WORD;
+    for (int c = '0'; c <= '9'; c++) table[c] |= WORD | DIGIT;
+    table['_'] |= WORD;
+    table['\n'] |= NEWLINE | STRING_STOP;
+    table['"'] |= STRING_STOP;
+    table['\\'] |= STRING_STOP;
+    return table;
+}
+
+inline constexpr std::array<uint8_t, 256> classTable = makeClassTable();
+
+inline bool inClass(char c, CharClass cls) {
+    return classTable[static_cast<unsigned char>(c)] & cls;
+}
+
+// Vectorized continuation of a run that is still going after the inline prefix
+size_t scanWide(std::string_view text, size_t pos, CharClass cls, bool member);
+
+// First index at or after pos whose membership in cls differs from `member`
+inline size_t scanRun(std::string_view text, size_t pos, CharClass cls, bool member) {
+    size_t end = pos + 16 < text.size() ? pos + 16 : text.size();
+    while (pos < end && inClass(text[pos], cls) == member) pos++;
+    if (pos < end || pos == text.size()) return pos;
+    return scanWide(text, pos, cls, member);
+}
+
+// Skip ' ', '\t' and '\r'
+inline size_t skipBlanks(std::string_view text, size_t pos) { return scanRun(text, pos, BLANK, true); }
+// Skip identifier characters: [A-Za-z0-9_]
+inline size_t skipWord(std::string_view text, size_t pos) { return scanRun(text, pos, WORD, true); }
+// Skip [0-9]
+inline size_t skipDigits(std::string_view text, size_t pos) { return scanRun(text, pos, DIGIT, true); }
+// Find the next '\n'
+inline size_t findNewline(std::string_view text, size_t pos) { return scanRun(text, pos, NEWLINE, false); }
+// Find the next byte a string literal has to stop at: '"', '\\' or '\n'
+inline size_t findStringStop(std::string_view text, size_t pos) { return scanRun(text, pos, STRING_STOP, false); }
+
+// "avx2", "sse2" or "skalar". BAHASA_SIMD=sse2|skalar forces a lower level.
+const char* implementation();
+
+} // namespace scan
+} // namespace bahasa
+
+#endif // BAHASA_SCAN_HPP
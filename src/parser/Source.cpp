@@ -0,0 +1,18 @@
+#include "Source.hpp"
+#include <stdexcept>
+
+namespace bahasa {
+
+SourceBuffer SourceBuffer::fromFile(const std::string& path) {
+    auto buffer = llvm::MemoryBuffer::getFile(path, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+    if (!buffer) {
+        throw std::runtime_error("Tidak dapat membuka berkas: " + path);
+    }
+    return SourceBuffer(std::move(*buffer));
+}
+
+SourceBuffer SourceBuffer::fromString(std::string_view text, const std::string& name) {
+    return SourceBuffer(llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef(text.data(), text.size()), name));
+}
+
+} // namespace bahasa
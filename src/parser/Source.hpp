@@ -0,0 +1,31 @@
+#ifndef BAHASA_SOURCE_HPP
+#define BAHASA_SOURCE_HPP
+
+#include <llvm/Support/MemoryBuffer.h>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace bahasa {
+
+// Source text of one compilation. Files are memory-mapped (for anything
+// larger than a few pages) rather than copied; tokens produced by the Lexer
+// point into this buffer, so it must outlive them.
+class SourceBuffer {
+public:
+    static SourceBuffer fromFile(const std::string& path);
+    static SourceBuffer fromString(std::string_view text, const std::string& name = "");
+
+    std::string_view text() const {
+        return std::string_view(buffer->getBufferStart(), buffer->getBufferSize());
+    }
+
+private:
+    explicit SourceBuffer(std::unique_ptr<llvm::MemoryBuffer> buffer) : buffer(std::move(buffer)) {}
+
+    std::unique_ptr<llvm::MemoryBuffer> buffer;
+};
+
+} // namespace bahasa
+
+#endif // BAHASA_SOURCE_HPP
@@ -0,0 +1,32 @@
+# Runs one example program and checks its output.
+#   BAHASA   the bahasa executable
+#   SOURCE   the .bh file
+#   MODE     "jalankan", or "susun" to build at -O0 and run the executable
+#   EXPECTED text the output must contain
+#   WORKDIR  where a built executable is written
+
+if(MODE STREQUAL "susun")
+    get_filename_component(name "${SOURCE}" NAME_WE)
+    set(program "${WORKDIR}/${name}")
+    execute_process(
+        COMMAND "${BAHASA}" susun --tanpa-layanan --tanpa-cache -O0 "${SOURCE}" -o "${program}"
+        RESULT_VARIABLE status
+        ERROR_VARIABLE errors)
+    if(NOT status EQUAL 0)
+        message(FATAL_ERROR "susun gagal (${status}):\n${errors}")
+    endif()
+    execute_process(COMMAND "${program}" OUTPUT_VARIABLE output RESULT_VARIABLE status)
+else()
+    execute_process(
+        COMMAND "${BAHASA}" jalankan --tanpa-layanan "${SOURCE}"
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE status)
+endif()
+
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "${MODE} ${SOURCE} keluar dengan kode ${status}:\n${output}")
+endif()
+string(FIND "${output}" "${EXPECTED}" found)
+if(found EQUAL -1)
+    message(FATAL_ERROR "Keluaran ${MODE} ${SOURCE} tidak memuat \"${EXPECTED}\":\n${output}")
+endif()